@@ -0,0 +1,327 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "graph.h"
+
+#define BENCH_GRAPH_FILE  "bench_graph.txt"
+#define BENCH_DOT_FILE    "bench_dot.txt"
+
+/* Usage: ./bench [-g er|rmat|grid|chain] [-n vertices] [-m edges] [-i iterations] [-s seed]
+* Builds one synthetic graph, times every public operation on it and prints the results as JSON.
+*/
+
+//Settings shared by every benchmark
+int iterations = 10000;
+int num_vertices = MAX_VERTICES;
+Graph *base = NULL;
+long *samples = NULL;
+int *arg_u = NULL;
+int *arg_v = NULL;
+int first_op = 1;
+
+//Helper function: monotonic clock in nanoseconds
+long now_ns() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+//Helper function for qsort on latencies
+int compare_long(const void *a, const void *b) {
+
+	long x = *(const long *)a;
+	long y = *(const long *)b;
+	return (x > y) - (x < y);
+}
+
+//Helper function: edge weight 1..9
+int random_weight() {
+	return 1 + rand() % 9;
+}
+
+// Generators
+//Erdos-Renyi G(n, m): m distinct random directed edges
+void generate_er(Graph *graph, int n, int m) {
+
+	int i;
+
+	for(i = 0; i < n; i++) {
+		graph_add_vertex(graph, i);
+	}
+
+	//Never ask for more edges than the matrix can hold
+	if(m > n * (n - 1)) {
+		m = n * (n - 1);
+	}
+
+	while(graph_num_edges(graph) < m) {
+
+		int u = rand() % n;
+		int v = rand() % n;
+
+		if(u != v) {
+			graph_add_edge(graph, u, v, random_weight());
+		}
+	}
+}
+
+//R-MAT: each edge picks a quadrant of the matrix (a=.57, b=.19, c=.19, d=.05) recursively
+void generate_rmat(Graph *graph, int n, int m) {
+
+	int i, tries;
+	int size = 1;
+
+	for(i = 0; i < n; i++) {
+		graph_add_vertex(graph, i);
+	}
+
+	while(size < n) {
+		size *= 2;
+	}
+
+	//Skewed graphs repeat edges a lot, so cap the attempts rather than the count
+	for(tries = 0; tries < m * 10 && graph_num_edges(graph) < m; tries++) {
+
+		int u = 0, v = 0, half;
+
+		for(half = size / 2; half >= 1; half /= 2) {
+
+			int r = rand() % 100;
+
+			if(r >= 57 && r < 76) {
+				v += half;
+			}
+			else if(r >= 76 && r < 95) {
+				u += half;
+			}
+			else if(r >= 95) {
+				u += half;
+				v += half;
+			}
+		}
+
+		if(u < n && v < n && u != v) {
+			graph_add_edge(graph, u, v, random_weight());
+		}
+	}
+}
+
+//Grid: vertices on a side x side lattice with edges right and down
+void generate_grid(Graph *graph, int n) {
+
+	int side = 1;
+	int i;
+
+	while((side + 1) * (side + 1) <= n) {
+		side++;
+	}
+
+	for(i = 0; i < n; i++) {
+
+		graph_add_vertex(graph, i);
+
+		if(i % side != side - 1 && i + 1 < n) {
+			graph_add_vertex(graph, i + 1);
+			graph_add_edge(graph, i, i + 1, random_weight());
+		}
+
+		if(i + side < n) {
+			graph_add_vertex(graph, i + side);
+			graph_add_edge(graph, i, i + side, random_weight());
+		}
+	}
+}
+
+//Chain: 0 -> 1 -> ... -> n-1, the deepest case for has_path
+void generate_chain(Graph *graph, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) {
+
+		graph_add_vertex(graph, i);
+
+		if(i > 0) {
+			graph_add_edge(graph, i - 1, i, random_weight());
+		}
+	}
+}
+
+// Operations
+/* Each operation runs once per sample on a fresh copy of the generated graph (restored outside the
+* timed region when it mutates) with random vertex arguments arg_u[k] and arg_v[k].
+*/
+void op_add_vertex(Graph *graph, int k) { graph_add_vertex(graph, arg_u[k]); }
+void op_remove_vertex(Graph *graph, int k) { graph_remove_vertex(graph, arg_u[k]); }
+void op_add_edge(Graph *graph, int k) { graph_add_edge(graph, arg_u[k], arg_v[k], 1 + k % 9); }
+void op_remove_edge(Graph *graph, int k) { graph_remove_edge(graph, arg_u[k], arg_v[k]); }
+void op_contains_vertex(Graph *graph, int k) { graph_contains_vertex(graph, arg_u[k]); }
+void op_contains_edge(Graph *graph, int k) { graph_contains_edge(graph, arg_u[k], arg_v[k]); }
+void op_num_vertices(Graph *graph, int k) { graph_num_vertices(graph); }
+void op_num_edges(Graph *graph, int k) { graph_num_edges(graph); }
+void op_total_weight(Graph *graph, int k) { graph_total_weight(graph); }
+void op_get_degree(Graph *graph, int k) { graph_get_degree(graph, arg_u[k]); }
+void op_get_edge_weight(Graph *graph, int k) { graph_get_edge_weight(graph, arg_u[k], arg_v[k]); }
+void op_is_neighbor(Graph *graph, int k) { graph_is_neighbor(graph, arg_u[k], arg_v[k]); }
+void op_get_successors(Graph *graph, int k) { free(graph_get_successors(graph, arg_u[k])); }
+void op_get_predecessors(Graph *graph, int k) { free(graph_get_predecessors(graph, arg_u[k])); }
+void op_has_path(Graph *graph, int k) { graph_has_path(graph, arg_u[k], arg_v[k]); }
+void op_clone(Graph *graph, int k) { free(graph_clone(graph)); }
+void op_connected_components(Graph *graph, int k) { int c[MAX_VERTICES]; graph_connected_components(graph, c); }
+void op_pagerank(Graph *graph, int k) { double r[MAX_VERTICES]; graph_pagerank(graph, 0.85, 100, 1e-6, r); }
+void op_triangle_count(Graph *graph, int k) { int c[MAX_VERTICES]; graph_triangle_count(graph, c); }
+void op_betweenness(Graph *graph, int k) { double c[MAX_VERTICES]; graph_betweenness(graph, 0, c); }
+void op_save_file(Graph *graph, int k) { graph_save_file(graph, BENCH_GRAPH_FILE); }
+void op_load_file(Graph *graph, int k) { graph_load_file(graph, BENCH_GRAPH_FILE); }
+void op_output_dot(Graph *graph, int k) { graph_output_dot(graph, BENCH_DOT_FILE); }
+
+//Helper function: times one operation and prints its JSON object
+void bench_op(char *name, void (*op)(Graph *, int), int mutates, int runs) {
+
+	Graph *graph = graph_clone(base);
+	long total = 0;
+	int k;
+
+	for(k = 0; k < runs; k++) {
+
+		long start = now_ns();
+		op(graph, k);
+		samples[k] = now_ns() - start;
+		total += samples[k];
+
+		//Undo the mutation so every sample sees the same graph
+		if(mutates) {
+			memcpy(graph, base, sizeof(Graph));
+		}
+	}
+
+	free(graph);
+	qsort(samples, runs, sizeof(long), compare_long);
+
+	printf("%s\n    {\"name\": \"%s\", \"runs\": %d, \"ops_per_sec\": %.1f, \"p50_ns\": %ld, \"p99_ns\": %ld}",
+		first_op ? "" : ",", name, runs, total > 0 ? runs * 1e9 / total : 0.0,
+		samples[runs / 2], samples[(int)(runs * 0.99)]);
+	first_op = 0;
+}
+
+int main(int argc, char *argv[]) {
+
+	char generator[10] = "er";
+	int num_edges = 4 * MAX_VERTICES;
+	unsigned int seed = 1;
+	int i;
+
+	//Parse the options, each takes one value
+	for(i = 1; i + 1 < argc; i += 2) {
+
+		if(strcmp(argv[i], "-g") == 0) {
+			strncpy(generator, argv[i + 1], sizeof(generator) - 1);
+		}
+		else if(strcmp(argv[i], "-n") == 0) {
+			num_vertices = atoi(argv[i + 1]);
+		}
+		else if(strcmp(argv[i], "-m") == 0) {
+			num_edges = atoi(argv[i + 1]);
+		}
+		else if(strcmp(argv[i], "-i") == 0) {
+			iterations = atoi(argv[i + 1]);
+		}
+		else if(strcmp(argv[i], "-s") == 0) {
+			seed = (unsigned int)atoi(argv[i + 1]);
+		}
+		else {
+			fprintf(stderr, "Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if(num_vertices < 1 || num_vertices > MAX_VERTICES || num_edges < 0 || iterations < 1) {
+		fprintf(stderr, "Usage: %s [-g er|rmat|grid|chain] [-n 1..%d] [-m edges] [-i iterations] [-s seed]\n", argv[0], MAX_VERTICES);
+		return 1;
+	}
+
+	srand(seed);
+	base = graph_initialize();
+	samples = malloc(sizeof(long) * iterations);
+	arg_u = malloc(sizeof(int) * iterations);
+	arg_v = malloc(sizeof(int) * iterations);
+
+	if(base == NULL || samples == NULL || arg_u == NULL || arg_v == NULL) {
+		fprintf(stderr, "Error in allocating benchmark buffers. Exiting...\n");
+		return 1;
+	}
+
+	if(strcmp(generator, "er") == 0) {
+		generate_er(base, num_vertices, num_edges);
+	}
+	else if(strcmp(generator, "rmat") == 0) {
+		generate_rmat(base, num_vertices, num_edges);
+	}
+	else if(strcmp(generator, "grid") == 0) {
+		generate_grid(base, num_vertices);
+	}
+	else if(strcmp(generator, "chain") == 0) {
+		generate_chain(base, num_vertices);
+	}
+	else {
+		fprintf(stderr, "Unknown generator %s\n", generator);
+		return 1;
+	}
+
+	for(i = 0; i < iterations; i++) {
+		arg_u[i] = rand() % num_vertices;
+		arg_v[i] = rand() % num_vertices;
+	}
+
+	printf("{\n  \"generator\": \"%s\",\n  \"vertices\": %d,\n  \"edges\": %d,\n  \"iterations\": %d,\n  \"seed\": %u,\n  \"operations\": [",
+		generator, graph_num_vertices(base), graph_num_edges(base), iterations, seed);
+
+	bench_op("add_vertex", op_add_vertex, 1, iterations);
+	bench_op("remove_vertex", op_remove_vertex, 1, iterations);
+	bench_op("add_edge", op_add_edge, 1, iterations);
+	bench_op("remove_edge", op_remove_edge, 1, iterations);
+	bench_op("contains_vertex", op_contains_vertex, 0, iterations);
+	bench_op("contains_edge", op_contains_edge, 0, iterations);
+	bench_op("num_vertices", op_num_vertices, 0, iterations);
+	bench_op("num_edges", op_num_edges, 0, iterations);
+	bench_op("total_weight", op_total_weight, 0, iterations);
+	bench_op("get_degree", op_get_degree, 0, iterations);
+	bench_op("get_edge_weight", op_get_edge_weight, 0, iterations);
+	bench_op("is_neighbor", op_is_neighbor, 0, iterations);
+	bench_op("get_successors", op_get_successors, 0, iterations);
+	bench_op("get_predecessors", op_get_predecessors, 0, iterations);
+	bench_op("has_path", op_has_path, 0, iterations);
+	bench_op("clone", op_clone, 0, iterations);
+	bench_op("connected_components", op_connected_components, 0, iterations);
+	bench_op("pagerank", op_pagerank, 0, iterations);
+	bench_op("triangle_count", op_triangle_count, 0, iterations);
+	bench_op("betweenness", op_betweenness, 0, iterations);
+
+	//File operations hit the disk, so they get fewer runs
+	int file_runs = (iterations < 1000) ? iterations : 1000;
+
+	bench_op("save_file", op_save_file, 0, file_runs);
+	bench_op("load_file", op_load_file, 1, file_runs);
+	bench_op("output_dot", op_output_dot, 0, file_runs);
+
+	remove(BENCH_GRAPH_FILE);
+	remove(BENCH_DOT_FILE);
+
+	//Peak resident set size (kilobytes on Linux)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	printf("\n  ],\n  \"peak_rss_kb\": %ld\n}\n", usage.ru_maxrss);
+
+	free(samples);
+	free(arg_u);
+	free(arg_v);
+	free(base);
+	return 0;
+}
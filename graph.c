@@ -1,9 +1,23 @@
+#ifdef GRAPH_STATS
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
+#ifdef GRAPH_STATS
+#include <time.h>
+#endif
+
 #include "graph.h"
 
+//Bitsets with one bit per vertex
+#define BITSET_WORDS        GRAPH_BITSET_WORDS
+#define BITSET_SET(b, i)    ((b)[(i) / 32] |= 1u << ((i) % 32))
+#define BITSET_CLEAR(b, i)  ((b)[(i) / 32] &= ~(1u << ((i) % 32)))
+#define BITSET_TEST(b, i)   (((b)[(i) / 32] >> ((i) % 32)) & 1u)
+
 /* Notes:
 * 1. Vertices are denoted by adj_matrix[i][i]
 * 2. Edges (weights) are denoted by adj_matrix[i][j], where i != j
@@ -11,28 +25,277 @@
 * 4. If a vertex exists, value is set as 0
 * 5. Weights from vertex v1 to v2 or v1 to v1 (self loop) are set as values > 0
 * 6. All return values are according to Project3_GL(5).pdf
+* 7. out_edges[i] and in_edges[j] mirror the matrix: bit j of out_edges[i] and bit i of in_edges[j] are set
+*    when adj_matrix[i][j] > 0. Lookups of one edge read the matrix; walks over a row or column iterate the
+*    set bits, so their cost follows the degree rather than max_vertex.
 */
 
 
-//Helper function for DFS:
-void depth_first_search(Graph *graph, int v1) {
+// Statistics (built only with -DGRAPH_STATS)
+#ifdef GRAPH_STATS
+
+//Per-thread statistics, linked into one list so snapshots can sum every thread's counters
+typedef struct stats_slot_struct {
+  GraphStats stats;
+  int depth;                          // nesting of public calls, only the outermost call is recorded
+  struct stats_slot_struct *next;
+} StatsSlot;
+
+//Slots are never freed, so counts from finished threads are kept
+StatsSlot *stats_slots = NULL;
+__thread StatsSlot *stats_local = NULL;
+
+//Only the owning thread writes its counters, so relaxed load+store is enough (no locked add)
+#define STATS_ADD(x, n)  __atomic_store_n(&(x), __atomic_load_n(&(x), __ATOMIC_RELAXED) + (n), __ATOMIC_RELAXED)
+
+//Helper function for statistics: returns this thread's slot, registering it on first use
+StatsSlot *stats_slot() {
+
+	if(stats_local == NULL) {
+
+		StatsSlot *slot = calloc(1, sizeof(StatsSlot));
+		if(slot == NULL) {
+			return NULL;
+		}
+
+		//Push onto the list head without a lock
+		slot->next = __atomic_load_n(&stats_slots, __ATOMIC_ACQUIRE);
+		while(!__atomic_compare_exchange_n(&stats_slots, &slot->next, slot, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+			//slot->next now holds the latest head, try again
+		}
+
+		stats_local = slot;
+	}
+
+	return stats_local;
+}
+
+typedef struct stats_scope_struct {
+  StatsSlot *slot;
+  int op;                             // -1 for nested calls, which are not recorded
+  struct timespec start;
+} StatsScope;
+
+//Helper function for statistics: starts timing a public call
+StatsScope stats_scope_begin(int op) {
+
+	StatsScope scope;
+
+	scope.slot = stats_slot();
+	scope.op = -1;
+
+	if(scope.slot != NULL && scope.slot->depth++ == 0) {
+		scope.op = op;
+		clock_gettime(CLOCK_MONOTONIC, &scope.start);
+	}
+
+	return scope;
+}
+
+//Helper function for statistics: runs when the scope of a public call ends and records its latency
+//in bucket b = floor(log2(ns))
+void stats_scope_end(StatsScope *scope) {
+
+	if(scope->slot == NULL) {
+		return;
+	}
+
+	scope->slot->depth--;
+
+	if(scope->op < 0) {
+		return;
+	}
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	unsigned long ns = (end.tv_sec - scope->start.tv_sec) * 1000000000UL + end.tv_nsec - scope->start.tv_nsec;
+	int bucket = 0;
+
+	while(bucket < GRAPH_STATS_BUCKETS - 1 && (ns >> (bucket + 1)) != 0) {
+		bucket++;
+	}
+
+	GraphStats *stats = &scope->slot->stats;
+	STATS_ADD(stats->calls[scope->op], 1);
+	STATS_ADD(stats->total_ns[scope->op], ns);
+	STATS_ADD(stats->latency[scope->op][bucket], 1);
+}
+
+//Helper function for statistics: a DFS walks every out-edge of each vertex it visits,
+//so the visited set alone gives both traversal counts
+void stats_traversal(Graph *graph, int *visited) {
+
+	StatsSlot *slot = stats_slot();
+	unsigned long vertices = 0, edges = 0;
+	int i, j;
+
+	if(slot == NULL) {
+		return;
+	}
+
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		if(visited[i]) {
+
+			vertices++;
+
+			for(j = 0; j <= graph->max_vertex; j++) {
+
+				if(graph->adj_matrix[i][j] > 0) {
+					edges++;
+				}
+			}
+		}
+	}
+
+	STATS_ADD(slot->stats.path_searches, 1);
+	STATS_ADD(slot->stats.path_vertices_visited, vertices);
+	STATS_ADD(slot->stats.path_edges_visited, edges);
+}
+
+#define STATS_SCOPE(op)                   StatsScope stats_scope __attribute__((cleanup(stats_scope_end))) = stats_scope_begin(op)
+#define STATS_TRAVERSAL(graph, visited)   stats_traversal(graph, visited)
+
+#else
+
+#define STATS_SCOPE(op)
+#define STATS_TRAVERSAL(graph, visited)
+
+#endif
+
+
+//Helper function for edge bits: clears every bit and sets them again from the matrix
+void edge_bits_rebuild(Graph *graph) {
+
+	int i, j;
+
+	memset(graph->out_edges, 0, sizeof(graph->out_edges));
+	memset(graph->in_edges, 0, sizeof(graph->in_edges));
+
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		for(j = 0; j <= graph->max_vertex; j++) {
+
+			if(graph->adj_matrix[i][j] > 0) {
+				BITSET_SET(graph->out_edges[i], j);
+				BITSET_SET(graph->in_edges[j], i);
+			}
+		}
+	}
+}
+
+//Helper function for edge bits: lists the successors (outgoing = 1) or predecessors (outgoing = 0) of v1
+//by walking its set bits. Each edge is confirmed in the matrix, so a bit left briefly stale by a concurrent
+//writer is never reported. With live = 1 an edge whose other endpoint no longer exists is skipped, as
+//graph_contains_edge() would; the counting operations pass 0 to see every valid cell like the matrix scans
+//they replaced. Returns the number of vertices written to list.
+int edge_bits_list(Graph *graph, int v1, int outgoing, int live, int *list) {
+
+	unsigned int *row = outgoing ? graph->out_edges[v1] : graph->in_edges[v1];
+	int count = 0;
+	int i;
+
+	for(i = 0; i < BITSET_WORDS; i++) {
+
+		unsigned int word = row[i];
+
+		while(word) {
+
+			int v2 = i * 32 + __builtin_ctz(word);
+			word &= word - 1;
+
+			if(v2 <= graph->max_vertex && (outgoing ? graph->adj_matrix[v1][v2] : graph->adj_matrix[v2][v1]) > 0 &&
+				(!live || graph->adj_matrix[v2][v2] != -1)) {
+				list[count++] = v2;
+			}
+		}
+	}
+
+	return count;
+}
+
+//Helper function for edge bits: brings the bits of edge v1->v2 in line with its matrix cell when other
+//threads may be writing the same cell. Whoever writes a bit last re-reads the cell afterwards and
+//repeats if it changed, so once writers stop the bits match the matrix.
+void edge_bits_sync_atomic(Graph *graph, int v1, int v2) {
+
+	unsigned int out_mask = 1u << (v2 % 32);
+	unsigned int in_mask = 1u << (v1 % 32);
+	int value;
+
+	do {
+
+		value = __atomic_load_n(&graph->adj_matrix[v1][v2], __ATOMIC_SEQ_CST);
+
+		if(value > 0) {
+			__atomic_fetch_or(&graph->out_edges[v1][v2 / 32], out_mask, __ATOMIC_SEQ_CST);
+			__atomic_fetch_or(&graph->in_edges[v2][v1 / 32], in_mask, __ATOMIC_SEQ_CST);
+		}
+		else {
+			__atomic_fetch_and(&graph->out_edges[v1][v2 / 32], ~out_mask, __ATOMIC_SEQ_CST);
+			__atomic_fetch_and(&graph->in_edges[v2][v1 / 32], ~in_mask, __ATOMIC_SEQ_CST);
+		}
+
+	} while((__atomic_load_n(&graph->adj_matrix[v1][v2], __ATOMIC_SEQ_CST) > 0) != (value > 0));
+}
+
+//Helper function for DFS (visited belongs to the caller so the graph itself is only read):
+void depth_first_search(Graph *graph, int *visited, int v1) {
 
 	int i;
 
 	//Set visited for v1 = 1
-    graph->visited[v1] = 1;
+    visited[v1] = 1;
 	
-	//For every valid path and a node that's not visited yet, call depth_first_search()
-	for(i = 0; i <= graph->max_vertex; i++) {
+	//For every successor that's not visited yet, call depth_first_search()
+	int list[MAX_VERTICES];
+	int count = edge_bits_list(graph, v1, 1, 0, list);
+
+	for(i = 0; i < count; i++) {
 
-       if((graph->adj_matrix[v1][i] > 0) && (graph->visited[i] == 0)) {
-            depth_first_search(graph, i);
+       if(visited[list[i]] == 0) {
+            depth_first_search(graph, visited, list[i]);
        }
 	}
 }
 
+//Helper function for union-find: returns the root of v1, halving the path on the way up (path splitting)
+int union_find_root(int *parent, int v1) {
+
+	while(parent[v1] != v1) {
+
+		parent[v1] = parent[parent[v1]];
+		v1 = parent[v1];
+	}
+
+	return v1;
+}
+
+//Helper function for union-find: merges the sets of v1 and v2. The smaller root always becomes the parent,
+//so every root is the smallest vertex of its set. Returns 1 if two sets were merged, else 0.
+int union_find_link(int *parent, int v1, int v2) {
+
+	v1 = union_find_root(parent, v1);
+	v2 = union_find_root(parent, v2);
+
+	if(v1 == v2) {
+		return 0;
+	}
+
+	if(v1 < v2) {
+		parent[v2] = v1;
+	}
+	else {
+		parent[v1] = v2;
+	}
+
+	return 1;
+}
+
 // Initialization Functions
 Graph *graph_initialize() {
+	STATS_SCOPE(GRAPH_OP_INITIALIZE);
 
 	int i, j;
 	
@@ -48,11 +311,6 @@ Graph *graph_initialize() {
 
     	graph_ptr -> max_vertex = -1; //Default max_vertex
     	
-    	//Default visited[]
-    	for(i = 0; i < MAX_VERTICES; i++) { 
-    		graph_ptr->visited[i] = 0;
-    	}
-    	
     	//Default adj_matrix[]
     	for(i = 0; i < MAX_VERTICES; i++) { 
     		for(j = 0; j < MAX_VERTICES; j++) {
@@ -60,13 +318,38 @@ Graph *graph_initialize() {
     		}
     	}
 
+    	//Default edge bits (no edges)
+    	memset(graph_ptr->out_edges, 0, sizeof(graph_ptr->out_edges));
+    	memset(graph_ptr->in_edges, 0, sizeof(graph_ptr->in_edges));
+
     	return graph_ptr;
   	}
 }
 
 
+Graph *graph_clone(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_CLONE);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return NULL;
+	}
+
+	//The whole graph is one fixed size block (MAX_VERTICES x MAX_VERTICES), so a copy is a single
+	//memcpy no matter how many vertices or edges it holds
+	Graph *graph_ptr = malloc(sizeof(Graph));
+
+	if(graph_ptr == NULL) {
+		return NULL;
+	}
+
+	memcpy(graph_ptr, graph, sizeof(Graph));
+	return graph_ptr;
+}
+
 // Vertex Operations
 int graph_add_vertex(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_ADD_VERTEX);
 
 	//Handler for malloc errors or invalid v1
 	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES) {
@@ -89,6 +372,7 @@ int graph_add_vertex(Graph *graph, int v1) {
 }
 
 int graph_contains_vertex(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_CONTAINS_VERTEX);
 
 	//Handler for malloc errors or invalid v1
 	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES) {
@@ -103,6 +387,7 @@ int graph_contains_vertex(Graph *graph, int v1) {
 }
 
 int graph_remove_vertex(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_REMOVE_VERTEX);
 
 	int i;
 
@@ -124,6 +409,13 @@ int graph_remove_vertex(Graph *graph, int v1) {
   		for(i = 0; i <= graph->max_vertex; i++) {
   			graph->adj_matrix[i][v1] = -1;
   		}
+  		//Clear the edge bits of the same cells
+  		for(i = 0; i <= graph->max_vertex; i++) {
+  			BITSET_CLEAR(graph->out_edges[v1], i);
+  			BITSET_CLEAR(graph->in_edges[i], v1);
+  			BITSET_CLEAR(graph->out_edges[i], v1);
+  			BITSET_CLEAR(graph->in_edges[v1], i);
+  		}
   		//Update max_vertex in case the recently deleted vertex was the max_vertex
   		int temp = graph->max_vertex;
   		graph->max_vertex = -1;
@@ -145,6 +437,7 @@ int graph_remove_vertex(Graph *graph, int v1) {
 
 // Edge Operations
 int graph_add_edge(Graph *graph, int v1, int v2, int wt) {
+	STATS_SCOPE(GRAPH_OP_ADD_EDGE);
 
 	//Handler for malloc errors or invalid v1 or v2
 	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES || v2 < 0 || v2 >= MAX_VERTICES) {
@@ -163,10 +456,13 @@ int graph_add_edge(Graph *graph, int v1, int v2, int wt) {
 
   	//set the corresponding edge with the weight and return success
   	graph->adj_matrix[v1][v2] = wt;
+  	BITSET_SET(graph->out_edges[v1], v2);
+  	BITSET_SET(graph->in_edges[v2], v1);
   	return 0;
 }
 
 int graph_contains_edge(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_CONTAINS_EDGE);
 
 	//Handler for malloc errors or invalid v1 or v2
 	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES || v2 < 0 || v2 >= MAX_VERTICES) {
@@ -188,12 +484,15 @@ int graph_contains_edge(Graph *graph, int v1, int v2) {
 }
 
 int graph_remove_edge(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_REMOVE_EDGE);
 
 	//Check if edge exists before removing
 	if(graph_contains_edge(graph, v1, v2)) {
 		
 		//Reset edge and return success
   		graph->adj_matrix[v1][v2] = -1;
+  		BITSET_CLEAR(graph->out_edges[v1], v2);
+  		BITSET_CLEAR(graph->in_edges[v2], v1);
   		return 0;
 	}
 
@@ -205,6 +504,7 @@ int graph_remove_edge(Graph *graph, int v1, int v2) {
 
 // Graph Metrics Operations
 int graph_num_vertices(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_NUM_VERTICES);
 
 	//Handler for malloc errors
 	if(graph == NULL) {
@@ -226,30 +526,27 @@ int graph_num_vertices(Graph *graph) {
 }
 
 int graph_num_edges(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_NUM_EDGES);
 
 	//Handler for malloc errors
 	if(graph == NULL) {
     	return -1;
   	}
 	
-	//Traverse the matrix and count the valid edges
+	//Count the successors of every vertex
+	int list[MAX_VERTICES];
 	int count = 0;
-	int i, j;
+	int i;
 
 	for(i = 0; i <= graph->max_vertex; i++) {
-
-		for(j = 0; j <= graph->max_vertex; j++) {
-
-			if(graph->adj_matrix[i][j] > 0) {
-				count++;
-			}
-		}
+		count += edge_bits_list(graph, i, 1, 0, list);
 	}
 	//Return count on success
 	return count;
 }
 
 int graph_total_weight(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_TOTAL_WEIGHT);
 	
 	//Handler for malloc errors
 	if(graph == NULL) {
@@ -276,6 +573,7 @@ int graph_total_weight(Graph *graph) {
 
 // Vertex Metrics Operations
 int graph_get_degree(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_GET_DEGREE);
 	
 	//Handler for malloc errors or invalid v1
 	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES) {
@@ -287,28 +585,17 @@ int graph_get_degree(Graph *graph, int v1) {
   		return -1;
   	}
 
-  	int count = 0;
-  	int i;
+  	int list[MAX_VERTICES];
 
-  	//Count all out degrees (adj_matrix[v1][i])
-  	for(i = 0; i <= graph->max_vertex; i++) {
-
-  		if(graph->adj_matrix[v1][i] > 0) {
-  			count++;
-  		}
-  	}
-  	//Count all in degrees (adj_matrix[i][v1])
-  	for(i = 0; i <= graph->max_vertex; i++) {
+  	//Count all out degrees (adj_matrix[v1][i]) and all in degrees (adj_matrix[i][v1])
+  	int count = edge_bits_list(graph, v1, 1, 0, list) + edge_bits_list(graph, v1, 0, 0, list);
 
-  		if(graph->adj_matrix[i][v1] > 0) {
-  			count++;
-  		}
-  	}
   	//Return total count on success
   	return count;
 }
 
 int graph_get_edge_weight(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_GET_EDGE_WEIGHT);
 	
 	//If graph contains edge, return its weight
 	if(graph_contains_edge(graph, v1, v2)) {
@@ -320,12 +607,18 @@ int graph_get_edge_weight(Graph *graph, int v1, int v2) {
 }
 
 int graph_is_neighbor(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_IS_NEIGHBOR);
 	
-	//Check if there is a edge from v1 to v2 or v2 to v1. Returns 1 on success and 0 on failures.
-	return (graph_contains_edge(graph, v1, v2) || graph_contains_edge(graph, v2, v1));
+	//Validate once, then check if there is a edge from v1 to v2 or v2 to v1. Returns 1 on success and 0 on failures.
+	if(!graph_contains_vertex(graph, v1) || !graph_contains_vertex(graph, v2)) {
+		return 0;
+	}
+
+	return (graph->adj_matrix[v1][v2] > 0 || graph->adj_matrix[v2][v1] > 0);
 }
 
 int *graph_get_predecessors(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_GET_PREDECESSORS);
 	
 	//For an invalid vertex, return error
 	if(!graph_contains_vertex(graph, v1)) {
@@ -333,37 +626,26 @@ int *graph_get_predecessors(Graph *graph, int v1) {
 	}
 	else {
 
-		//Count the number of predecessors of v1
-		int count = 0;
-		int i;
-
-		for(i = 0; i <= graph->max_vertex; i++) {
-
-			if(graph_contains_edge(graph, i, v1)) {
-				count++; 
-			}
-		}
+		//Collect the predecessors of v1 from its edge bits in one pass
+		int list[MAX_VERTICES];
+		int count = edge_bits_list(graph, v1, 0, 1, list);
 
 		//Malloc a dynamic array with that count +1 (for the extra -1 at the end)
 		int *arr = malloc(sizeof(int) * (count+1));
-		int j = 0;
-
-		//Move all predecessors in the malloc'd array and return it
-		for(i = 0; i <= graph->max_vertex; i++) {
-
-			if(graph_contains_edge(graph, i, v1)) {
-				arr[j] = i;
-				j++; 
-			}
+		if(arr == NULL) {
+			return NULL;
 		}
 
-		arr[j] = -1;
+		//Move all predecessors in the malloc'd array and return it
+		memcpy(arr, list, sizeof(int) * count);
+		arr[count] = -1;
 
 		return arr;
 	}
 }
 
 int *graph_get_successors(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_GET_SUCCESSORS);
 	
 	//For an invalid vertex, return error
 	if(!graph_contains_vertex(graph, v1)) {
@@ -371,38 +653,150 @@ int *graph_get_successors(Graph *graph, int v1) {
 	}
 	else {
 
-		//Count the number of successors of v1
-		int count = 0;
-		int i;
+		//Collect the successors of v1 from its edge bits in one pass
+		int list[MAX_VERTICES];
+		int count = edge_bits_list(graph, v1, 1, 1, list);
 
-		for(i = 0; i <= graph->max_vertex; i++) {
+		//Malloc a dynamic array with that count +1 (for the extra -1 at the end)
+		int *arr = malloc(sizeof(int) * (count+1));
+		if(arr == NULL) {
+			return NULL;
+		}
+
+		//Move all successors in the malloc'd array and return it
+		memcpy(arr, list, sizeof(int) * count);
+		arr[count] = -1;
+
+		return arr;
+	}
+}
+
+int *graph_top_k_edges(Graph *graph, int v1, int k) {
+	STATS_SCOPE(GRAPH_OP_TOP_K_EDGES);
+
+	//For an invalid vertex or k, return error
+	if(!graph_contains_vertex(graph, v1) || k < 0) {
+		return NULL;
+	}
+
+	int list[MAX_VERTICES];
+	int count = edge_bits_list(graph, v1, 1, 1, list);
+	int top = 0;
+	int i, j;
+
+	if(k > count) {
+		k = count;
+	}
+
+	//Keep the k heaviest successors in order, inserting each one into place (ties keep id order)
+	int *arr = malloc(sizeof(int) * (k+1));
+	if(arr == NULL) {
+		return NULL;
+	}
+
+	for(i = 0; i < count; i++) {
+
+		int wt = graph->adj_matrix[v1][list[i]];
+
+		if(top == k && (k == 0 || graph->adj_matrix[v1][arr[k-1]] >= wt)) {
+			continue;
+		}
+
+		j = (top < k) ? top++ : k - 1;
+
+		for(; j > 0 && graph->adj_matrix[v1][arr[j-1]] < wt; j--) {
+			arr[j] = arr[j-1];
+		}
+
+		arr[j] = list[i];
+	}
+
+	arr[top] = -1;
+
+	return arr;
+}
+
+int *graph_edges_in_weight_range(Graph *graph, int min_wt, int max_wt) {
+	STATS_SCOPE(GRAPH_OP_EDGES_IN_WEIGHT_RANGE);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return NULL;
+	}
+
+	int list[MAX_VERTICES];
+	int count = 0;
+	int i, j, n;
+
+	//Count the matching edges first, walking only the successors of each vertex
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		n = edge_bits_list(graph, i, 1, 1, list);
 
-			if(graph_contains_edge(graph, v1, i)) {
-				count++; 
+		for(j = 0; j < n; j++) {
+
+			if(graph->adj_matrix[i][list[j]] >= min_wt && graph->adj_matrix[i][list[j]] <= max_wt) {
+				count++;
 			}
 		}
+	}
 
-		//Malloc a dynamic array with that count +1 (for the extra -1 at the end)
-		int *arr = malloc(sizeof(int) * (count+1));
-		int j = 0;
+	//Malloc a dynamic array with two entries (v1, v2) per edge +1 (for the extra -1 at the end)
+	int *arr = malloc(sizeof(int) * (2*count+1));
+	int k = 0;
 
-		//Move all successors in the malloc'd array and return it
-		for(i = 0; i <= graph->max_vertex; i++) {
+	if(arr == NULL) {
+		return NULL;
+	}
+
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		n = edge_bits_list(graph, i, 1, 1, list);
 
-			if(graph_contains_edge(graph, v1, i)) {
-				arr[j] = i;
-				j++; 
+		for(j = 0; j < n; j++) {
+
+			if(graph->adj_matrix[i][list[j]] >= min_wt && graph->adj_matrix[i][list[j]] <= max_wt) {
+				arr[k++] = i;
+				arr[k++] = list[j];
 			}
 		}
+	}
 
-		arr[j] = -1;
+	arr[k] = -1;
 
-		return arr;
+	return arr;
+}
+
+int graph_weighted_degree(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_WEIGHTED_DEGREE);
+
+	//For an invalid vertex, return error
+	if(!graph_contains_vertex(graph, v1)) {
+		return -1;
+	}
+
+	int list[MAX_VERTICES];
+	int sum = 0;
+	int i, n;
+
+	//Sum the weights of all out edges (adj_matrix[v1][i]) and all in edges (adj_matrix[i][v1]),
+	//counted the same way as graph_get_degree
+	n = edge_bits_list(graph, v1, 1, 0, list);
+	for(i = 0; i < n; i++) {
+		sum += graph->adj_matrix[v1][list[i]];
+	}
+
+	n = edge_bits_list(graph, v1, 0, 0, list);
+	for(i = 0; i < n; i++) {
+		sum += graph->adj_matrix[list[i]][v1];
 	}
+	//Return sum on success
+	return sum;
 }
 
 //Graph Path Operations
 int graph_has_path(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_HAS_PATH);
 	
 	//For any invalid vertex, return Error
 	if(!graph_contains_vertex(graph, v1) || !graph_contains_vertex(graph, v2)) {
@@ -412,10 +806,12 @@ int graph_has_path(Graph *graph, int v1, int v2) {
 	else {
 
 		int i;
+		int visited[MAX_VERTICES];
 
 		//Every time this function is called, reset the visited array to avoid discrepencies
+		//(kept on the stack so concurrent readers of the same graph don't share it)
 		for(i = 0; i < MAX_VERTICES; i++) { 
-    		graph->visited[i] = 0;
+    		visited[i] = 0;
     	}
 
     	//Handler for a case when the function wants to check if a path exists from v1 to itself.
@@ -440,14 +836,15 @@ int graph_has_path(Graph *graph, int v1, int v2) {
 					//Call DFS on each of the successor and set all visitable vertices to 1.
 					while(arr[j] != -1) {
 						
-						depth_first_search(graph, arr[j]);
+						depth_first_search(graph, visited, arr[j]);
 						j++;
 					}
 
 					free(arr);
+					STATS_TRAVERSAL(graph, visited);
 
 					//If a path to v2 (which in this case is = v1) is found, return Success.
-					if(graph->visited[v2]) {
+					if(visited[v2]) {
 						return 1;
 					}
 					//Else return failure.
@@ -459,10 +856,11 @@ int graph_has_path(Graph *graph, int v1, int v2) {
     	else {
 
     		//Call depth_first_search and set the visitable nodes to 1.
-			depth_first_search(graph, v1);
+			depth_first_search(graph, visited, v1);
+			STATS_TRAVERSAL(graph, visited);
 
 			//If a path is found, return Success.
-			if(graph->visited[v2]) {
+			if(visited[v2]) {
 				return 1;
 			}
 			//Else return failure.
@@ -472,17 +870,1077 @@ int graph_has_path(Graph *graph, int v1, int v2) {
 }
 
 
-// Input/Output Operations
-void graph_print(Graph *graph) {
-	
-	//Handler for malloc errors
-	if(graph == NULL) {
-    	return;
-  	}
-  	//Handler for the case when the graph is just initialized
-  	if(graph->max_vertex == -1) {
-  		printf("\nNo elements in the Graph currently.");
-  		return;
+// Graph Analytics Operations
+int graph_connected_components(Graph *graph, int *components) {
+	STATS_SCOPE(GRAPH_OP_CONNECTED_COMPONENTS);
+
+	//Handler for malloc errors or missing output array
+	if(graph == NULL || components == NULL) {
+		return -1;
+	}
+
+	int parent[MAX_VERTICES];
+	int count = 0;
+	int i, j;
+
+	//Every vertex starts as its own set
+	for(i = 0; i < MAX_VERTICES; i++) {
+		parent[i] = i;
+	}
+
+	//Every edge (in either direction) merges the sets of its endpoints. Self loops never merge anything.
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		for(j = 0; j <= graph->max_vertex; j++) {
+
+			if(i != j && graph->adj_matrix[i][j] > 0) {
+				union_find_link(parent, i, j);
+			}
+		}
+	}
+
+	//Label each vertex with the smallest vertex of its component (-1 if the vertex doesn't exist)
+	for(i = 0; i < MAX_VERTICES; i++) {
+
+		if(i <= graph->max_vertex && graph->adj_matrix[i][i] != -1) {
+
+			components[i] = union_find_root(parent, i);
+
+			if(components[i] == i) {
+				count++;
+			}
+		}
+		else {
+			components[i] = -1;
+		}
+	}
+	//Return number of components on success
+	return count;
+}
+
+//Helper function for PageRank: power iteration pulling rank over in-edges (adj_matrix[u][v]) with the
+//given teleport distribution. Returns the number of iterations run, or -1 on invalid parameters.
+int pagerank_iterate(Graph *graph, double *teleport, double damping, int max_iter, double tolerance, double *ranks) {
+
+	if(damping < 0 || damping >= 1 || max_iter <= 0 || tolerance < 0) {
+		return -1;
+	}
+
+	double next[MAX_VERTICES];
+	double share[MAX_VERTICES];
+	int out_degree[MAX_VERTICES];
+	int n = graph->max_vertex + 1;
+	int iter, i, j;
+
+	//Out degrees never change during the iteration, so count them once
+	for(i = 0; i < n; i++) {
+
+		out_degree[i] = 0;
+
+		for(j = 0; j < n; j++) {
+
+			if(graph->adj_matrix[i][j] > 0) {
+				out_degree[i]++;
+			}
+		}
+	}
+
+	//Start from the teleport distribution
+	for(i = 0; i < MAX_VERTICES; i++) {
+		ranks[i] = (i < n) ? teleport[i] : 0;
+	}
+
+	for(iter = 1; iter <= max_iter; iter++) {
+
+		//Rank each vertex pushes along each of its out-edges; dangling vertices spread theirs by teleport
+		double dangling = 0;
+
+		for(i = 0; i < n; i++) {
+
+			if(out_degree[i] > 0) {
+				share[i] = ranks[i] / out_degree[i];
+			}
+			else {
+				share[i] = 0;
+				dangling += ranks[i];
+			}
+		}
+
+		//Pull: each vertex sums the shares of its predecessors (one column of the matrix)
+		double diff = 0;
+
+		for(j = 0; j < n; j++) {
+
+			double sum = 0;
+
+			for(i = 0; i < n; i++) {
+
+				if(graph->adj_matrix[i][j] > 0) {
+					sum += share[i];
+				}
+			}
+
+			next[j] = (1 - damping + damping * dangling) * teleport[j] + damping * sum;
+			diff += (next[j] > ranks[j]) ? next[j] - ranks[j] : ranks[j] - next[j];
+		}
+
+		for(j = 0; j < n; j++) {
+			ranks[j] = next[j];
+		}
+
+		//Stop once the L1 change falls below the tolerance
+		if(diff < tolerance) {
+			break;
+		}
+	}
+
+	return (iter > max_iter) ? max_iter : iter;
+}
+
+int graph_pagerank(Graph *graph, double damping, int max_iter, double tolerance, double *ranks) {
+	STATS_SCOPE(GRAPH_OP_PAGERANK);
+
+	//Handler for malloc errors, an empty graph or missing output array
+	if(graph == NULL || ranks == NULL || graph_num_vertices(graph) <= 0) {
+		return -1;
+	}
+
+	double teleport[MAX_VERTICES];
+	int n = graph_num_vertices(graph);
+	int i;
+
+	//Uniform teleport over the existing vertices
+	for(i = 0; i < MAX_VERTICES; i++) {
+		teleport[i] = graph_contains_vertex(graph, i) ? 1.0 / n : 0;
+	}
+
+	return pagerank_iterate(graph, teleport, damping, max_iter, tolerance, ranks);
+}
+
+int graph_personalized_pagerank(Graph *graph, int v1, double damping, int max_iter, double tolerance, double *ranks) {
+	STATS_SCOPE(GRAPH_OP_PERSONALIZED_PAGERANK);
+
+	//For an invalid vertex or missing output array, return error
+	if(!graph_contains_vertex(graph, v1) || ranks == NULL) {
+		return -1;
+	}
+
+	double teleport[MAX_VERTICES];
+	int i;
+
+	//All teleports jump back to v1
+	for(i = 0; i < MAX_VERTICES; i++) {
+		teleport[i] = (i == v1) ? 1.0 : 0;
+	}
+
+	return pagerank_iterate(graph, teleport, damping, max_iter, tolerance, ranks);
+}
+
+//Helper function for bitsets: number of bits set in both a and b
+int bitset_and_count(unsigned int *a, unsigned int *b) {
+
+	int count = 0;
+	int i;
+
+	for(i = 0; i < BITSET_WORDS; i++) {
+
+		unsigned int word = a[i] & b[i];
+
+		//Clear the lowest set bit until none are left
+		while(word) {
+			word &= word - 1;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+//Helper function for triangles: fills nbr[v] with the neighbours of v in the undirected view of the graph
+//(an edge in either direction, self loops ignored)
+void undirected_bitsets(Graph *graph, unsigned int nbr[][BITSET_WORDS]) {
+
+	int i, j;
+
+	//Union of each vertex's successor and predecessor bits, without itself and without anything past max_vertex
+	for(i = 0; i < MAX_VERTICES; i++) {
+
+		for(j = 0; j < BITSET_WORDS; j++) {
+			nbr[i][j] = (i <= graph->max_vertex) ? graph->out_edges[i][j] | graph->in_edges[i][j] : 0;
+		}
+
+		for(j = graph->max_vertex + 1; j < MAX_VERTICES; j++) {
+			BITSET_CLEAR(nbr[i], j);
+		}
+
+		BITSET_CLEAR(nbr[i], i);
+	}
+}
+
+int graph_triangle_count(Graph *graph, int *counts) {
+	STATS_SCOPE(GRAPH_OP_TRIANGLE_COUNT);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return -1;
+	}
+
+	unsigned int nbr[MAX_VERTICES][BITSET_WORDS];
+	unsigned int higher[MAX_VERTICES][BITSET_WORDS];
+	int degree[MAX_VERTICES];
+	int total = 0;
+	int u, w, x;
+
+	undirected_bitsets(graph, nbr);
+
+	for(u = 0; u < MAX_VERTICES; u++) {
+		degree[u] = bitset_and_count(nbr[u], nbr[u]);
+	}
+
+	//Orient every edge from lower to higher (degree, id) so each triangle is found exactly once,
+	//and high degree vertices keep short lists
+	memset(higher, 0, sizeof(higher));
+
+	for(u = 0; u <= graph->max_vertex; u++) {
+
+		for(w = 0; w <= graph->max_vertex; w++) {
+
+			if(BITSET_TEST(nbr[u], w) && (degree[u] < degree[w] || (degree[u] == degree[w] && u < w))) {
+				BITSET_SET(higher[u], w);
+			}
+		}
+	}
+
+	if(counts != NULL) {
+		for(u = 0; u < MAX_VERTICES; u++) {
+			counts[u] = graph_contains_vertex(graph, u) ? 0 : -1;
+		}
+	}
+
+	//For every oriented edge u->w, the common higher neighbours x close a triangle
+	for(u = 0; u <= graph->max_vertex; u++) {
+
+		for(w = 0; w <= graph->max_vertex; w++) {
+
+			if(!BITSET_TEST(higher[u], w) || bitset_and_count(higher[u], higher[w]) == 0) {
+				continue;
+			}
+
+			for(x = 0; x <= graph->max_vertex; x++) {
+
+				if(BITSET_TEST(higher[u], x) && BITSET_TEST(higher[w], x)) {
+
+					total++;
+
+					if(counts != NULL) {
+						counts[u]++;
+						counts[w]++;
+						counts[x]++;
+					}
+				}
+			}
+		}
+	}
+	//Return total number of triangles on success
+	return total;
+}
+
+double graph_clustering_coefficient(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_CLUSTERING_COEFFICIENT);
+
+	//For an invalid vertex, return error
+	if(!graph_contains_vertex(graph, v1)) {
+		return -1;
+	}
+
+	unsigned int nbr[MAX_VERTICES][BITSET_WORDS];
+	int links = 0;
+	int degree, w;
+
+	undirected_bitsets(graph, nbr);
+	degree = bitset_and_count(nbr[v1], nbr[v1]);
+
+	//Clustering is undefined below two neighbours, report 0
+	if(degree < 2) {
+		return 0;
+	}
+
+	//Every link between two neighbours of v1 is seen once from each end
+	for(w = 0; w <= graph->max_vertex; w++) {
+
+		if(BITSET_TEST(nbr[v1], w)) {
+			links += bitset_and_count(nbr[v1], nbr[w]);
+		}
+	}
+
+	return (double)links / (degree * (degree - 1));
+}
+
+//Helper function for betweenness: one Brandes pass from source s. Runs Dijkstra over the edge weights
+//(equal weights behave exactly like BFS), then accumulates dependencies in reverse settle order.
+void betweenness_from_source(Graph *graph, int s, double *centrality) {
+
+	long dist[MAX_VERTICES];
+	double sigma[MAX_VERTICES];
+	double delta[MAX_VERTICES];
+	int settled[MAX_VERTICES];
+	int order[MAX_VERTICES];
+	int n = graph->max_vertex + 1;
+	int count = 0;
+	int i, v, w;
+
+	for(i = 0; i < n; i++) {
+		dist[i] = -1;
+		sigma[i] = 0;
+		delta[i] = 0;
+		settled[i] = 0;
+	}
+
+	dist[s] = 0;
+	sigma[s] = 1;
+
+	//Settle the closest unsettled vertex until none are reachable
+	while(1) {
+
+		v = -1;
+		for(i = 0; i < n; i++) {
+
+			if(!settled[i] && dist[i] != -1 && (v == -1 || dist[i] < dist[v])) {
+				v = i;
+			}
+		}
+
+		if(v == -1) {
+			break;
+		}
+
+		settled[v] = 1;
+		order[count++] = v;
+
+		for(w = 0; w < n; w++) {
+
+			if(w == v || graph->adj_matrix[v][w] <= 0) {
+				continue;
+			}
+
+			long alt = dist[v] + graph->adj_matrix[v][w];
+
+			//A shorter path resets the count, an equally short one adds to it
+			if(dist[w] == -1 || alt < dist[w]) {
+				dist[w] = alt;
+				sigma[w] = sigma[v];
+			}
+			else if(alt == dist[w]) {
+				sigma[w] += sigma[v];
+			}
+		}
+	}
+
+	//Walk back from the farthest vertex; v is a predecessor of w if a shortest path runs over v->w
+	for(i = count - 1; i > 0; i--) {
+
+		w = order[i];
+
+		for(v = 0; v < n; v++) {
+
+			if(v != w && graph->adj_matrix[v][w] > 0 && dist[v] != -1 && dist[v] + graph->adj_matrix[v][w] == dist[w]) {
+				delta[v] += sigma[v] / sigma[w] * (1 + delta[w]);
+			}
+		}
+
+		centrality[w] += delta[w];
+	}
+}
+
+int graph_betweenness(Graph *graph, int samples, double *centrality) {
+	STATS_SCOPE(GRAPH_OP_BETWEENNESS);
+
+	//Handler for malloc errors or missing output array
+	if(graph == NULL || centrality == NULL) {
+		return -1;
+	}
+
+	int sources[MAX_VERTICES];
+	int n = 0;
+	int i;
+
+	//Collect the existing vertices as candidate sources
+	for(i = 0; i < MAX_VERTICES; i++) {
+
+		centrality[i] = 0;
+
+		if(graph_contains_vertex(graph, i)) {
+			sources[n++] = i;
+		}
+	}
+
+	//Exact mode uses every vertex as a source
+	if(samples <= 0 || samples > n) {
+		samples = n;
+	}
+
+	//Sampled mode picks the sources with a partial Fisher-Yates shuffle (seed with srand())
+	if(samples < n) {
+
+		for(i = 0; i < samples; i++) {
+
+			int j = i + rand() % (n - i);
+			int temp = sources[i];
+			sources[i] = sources[j];
+			sources[j] = temp;
+		}
+	}
+
+	for(i = 0; i < samples; i++) {
+		betweenness_from_source(graph, sources[i], centrality);
+	}
+
+	//Scale sampled scores up to estimate the exact ones
+	if(samples > 0 && samples < n) {
+
+		for(i = 0; i < MAX_VERTICES; i++) {
+			centrality[i] = centrality[i] * n / samples;
+		}
+	}
+	//Return number of sources used on success
+	return samples;
+}
+
+int graph_bandwidth(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_BANDWIDTH);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return -1;
+	}
+
+	int bandwidth = 0;
+	int i, j;
+
+	//Largest distance between the two endpoints of any edge
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		for(j = 0; j <= graph->max_vertex; j++) {
+
+			if(graph->adj_matrix[i][j] > 0 && abs(i - j) > bandwidth) {
+				bandwidth = abs(i - j);
+			}
+		}
+	}
+	//Return bandwidth on success
+	return bandwidth;
+}
+
+//Helper function for reordering: breadth first order over the undirected neighbours nbr, one component at a time.
+//With by_degree set, each component starts at its lowest degree vertex and neighbours are queued in
+//increasing degree (Cuthill-McKee), otherwise both go by vertex id. Returns the number of vertices ordered.
+int reorder_breadth_first(Graph *graph, unsigned int nbr[][BITSET_WORDS], int *degree, int by_degree, int *order) {
+
+	int queued[MAX_VERTICES] = {0};
+	int head = 0, tail = 0;
+	int i, j, v;
+
+	while(1) {
+
+		//Pick the start of the next component
+		int start = -1;
+
+		for(i = 0; i <= graph->max_vertex; i++) {
+
+			if(graph_contains_vertex(graph, i) && !queued[i] && (start == -1 || (by_degree && degree[i] < degree[start]))) {
+				start = i;
+			}
+		}
+
+		if(start == -1) {
+			break;
+		}
+
+		queued[start] = 1;
+		order[tail++] = start;
+
+		while(head < tail) {
+
+			v = order[head++];
+			int first = tail;
+
+			for(i = 0; i <= graph->max_vertex; i++) {
+
+				if(BITSET_TEST(nbr[v], i) && !queued[i]) {
+					queued[i] = 1;
+					order[tail++] = i;
+				}
+			}
+
+			//Insertion sort the newly queued neighbours by degree (stable, so ties keep id order)
+			if(by_degree) {
+
+				for(i = first + 1; i < tail; i++) {
+
+					int temp = order[i];
+
+					for(j = i; j > first && degree[order[j - 1]] > degree[temp]; j--) {
+						order[j] = order[j - 1];
+					}
+
+					order[j] = temp;
+				}
+			}
+		}
+	}
+
+	return tail;
+}
+
+int graph_reorder(Graph *graph, int strategy, int *old_ids, int *new_ids, int *bandwidth_before) {
+	STATS_SCOPE(GRAPH_OP_REORDER);
+
+	//Handler for malloc errors, missing output array or unknown strategy
+	if(graph == NULL || old_ids == NULL || strategy < GRAPH_ORDER_RCM || strategy > GRAPH_ORDER_BFS) {
+		return -1;
+	}
+
+	unsigned int nbr[MAX_VERTICES][BITSET_WORDS];
+	int new_matrix[MAX_VERTICES][MAX_VERTICES];
+	int order[MAX_VERTICES];
+	int degree[MAX_VERTICES];
+	int n = 0;
+	int i, j;
+
+	if(bandwidth_before != NULL) {
+		*bandwidth_before = graph_bandwidth(graph);
+	}
+
+	//Degree in the undirected view, so two-way edges and self loops count once and not at all
+	undirected_bitsets(graph, nbr);
+
+	for(i = 0; i < MAX_VERTICES; i++) {
+		degree[i] = bitset_and_count(nbr[i], nbr[i]);
+	}
+
+	if(strategy == GRAPH_ORDER_DEGREE) {
+
+		//Most neighbours first, ties by vertex id
+		for(i = 0; i <= graph->max_vertex; i++) {
+
+			if(!graph_contains_vertex(graph, i)) {
+				continue;
+			}
+
+			for(j = n; j > 0 && degree[order[j - 1]] < degree[i]; j--) {
+				order[j] = order[j - 1];
+			}
+
+			order[j] = i;
+			n++;
+		}
+	}
+	else {
+
+		n = reorder_breadth_first(graph, nbr, degree, strategy == GRAPH_ORDER_RCM, order);
+
+		//Reverse Cuthill-McKee is the Cuthill-McKee order read backwards
+		if(strategy == GRAPH_ORDER_RCM) {
+
+			for(i = 0; i < n / 2; i++) {
+
+				int temp = order[i];
+				order[i] = order[n - 1 - i];
+				order[n - 1 - i] = temp;
+			}
+		}
+	}
+
+	//Vertex order[i] becomes vertex i, so existing vertices are packed into 0..n-1
+	if(new_ids != NULL) {
+
+		for(i = 0; i < MAX_VERTICES; i++) {
+			new_ids[i] = -1;
+		}
+
+		for(i = 0; i < n; i++) {
+			new_ids[order[i]] = i;
+		}
+	}
+
+	for(i = 0; i < MAX_VERTICES; i++) {
+
+		old_ids[i] = (i < n) ? order[i] : -1;
+
+		for(j = 0; j < MAX_VERTICES; j++) {
+			new_matrix[i][j] = (i < n && j < n) ? graph->adj_matrix[order[i]][order[j]] : -1;
+		}
+	}
+
+	memcpy(graph->adj_matrix, new_matrix, sizeof(new_matrix));
+	graph->max_vertex = n - 1;
+	edge_bits_rebuild(graph);
+
+	//Return the bandwidth of the new numbering on success
+	return graph_bandwidth(graph);
+}
+
+
+//Helper function for subgraphs: new graph holding the vertices marked in in_set and every edge between them,
+//copied row by row in a single pass (vertex ids are kept)
+Graph *induced_copy(Graph *graph, int *in_set) {
+
+	Graph *sub = graph_initialize();
+	int i, j;
+
+	if(sub == NULL) {
+		return NULL;
+	}
+
+	for(i = 0; i <= graph->max_vertex; i++) {
+
+		if(!in_set[i]) {
+			continue;
+		}
+
+		for(j = 0; j <= graph->max_vertex; j++) {
+
+			if(in_set[j]) {
+				sub->adj_matrix[i][j] = graph->adj_matrix[i][j];
+			}
+		}
+
+		sub->max_vertex = i;
+	}
+
+	edge_bits_rebuild(sub);
+	return sub;
+}
+
+Graph *graph_khop(Graph *graph, int v1, int k, int direction) {
+	STATS_SCOPE(GRAPH_OP_KHOP);
+
+	//For an invalid vertex, hop count or direction, return error
+	if(!graph_contains_vertex(graph, v1) || k < 0 || direction < GRAPH_DIR_OUT || direction > GRAPH_DIR_BOTH) {
+		return NULL;
+	}
+
+	int in_set[MAX_VERTICES] = {0};
+	int queue[MAX_VERTICES];
+	int head = 0, tail = 0;
+	int hop, i;
+
+	in_set[v1] = 1;
+	queue[tail++] = v1;
+
+	//Breadth first, one hop (one frontier of the queue) at a time
+	for(hop = 0; hop < k && head < tail; hop++) {
+
+		int frontier_end = tail;
+
+		for(; head < frontier_end; head++) {
+
+			int v = queue[head];
+
+			for(i = 0; i <= graph->max_vertex; i++) {
+
+				if(in_set[i]) {
+					continue;
+				}
+
+				if((direction != GRAPH_DIR_IN && graph->adj_matrix[v][i] > 0) ||
+				   (direction != GRAPH_DIR_OUT && graph->adj_matrix[i][v] > 0)) {
+					in_set[i] = 1;
+					queue[tail++] = i;
+				}
+			}
+		}
+	}
+
+	return induced_copy(graph, in_set);
+}
+
+Graph *graph_induced_subgraph(Graph *graph, int *vertices) {
+	STATS_SCOPE(GRAPH_OP_INDUCED_SUBGRAPH);
+
+	//Handler for malloc errors or missing vertex list
+	if(graph == NULL || vertices == NULL) {
+		return NULL;
+	}
+
+	int in_set[MAX_VERTICES] = {0};
+	int i;
+
+	//Mark every listed vertex (the list ends with -1, like graph_get_successors); any invalid one is an error
+	for(i = 0; vertices[i] != -1; i++) {
+
+		if(!graph_contains_vertex(graph, vertices[i])) {
+			return NULL;
+		}
+
+		in_set[vertices[i]] = 1;
+	}
+
+	return induced_copy(graph, in_set);
+}
+
+//Helper function for spanning forests: 1 if undirected edge (u1, v1, w1) sorts before (u2, v2, w2),
+//by weight then by endpoints. A strict total order keeps Boruvka from closing cycles on equal weights.
+int msf_edge_less(int u1, int v1, int w1, int u2, int v2, int w2) {
+
+	if(w1 != w2) {
+		return w1 < w2;
+	}
+	if(u1 != u2) {
+		return u1 < u2;
+	}
+	return v1 < v2;
+}
+
+int *graph_minimum_spanning_forest(Graph *graph, int *total_weight) {
+	STATS_SCOPE(GRAPH_OP_MINIMUM_SPANNING_FOREST);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return NULL;
+	}
+
+	int parent[MAX_VERTICES];
+	int best_u[MAX_VERTICES], best_v[MAX_VERTICES], best_w[MAX_VERTICES];
+	int chosen[2*MAX_VERTICES];
+	int count = 0, sum = 0, merged = 1;
+	int i, u, v;
+
+	for(i = 0; i < MAX_VERTICES; i++) {
+		parent[i] = i;
+	}
+
+	//Each round every component picks its cheapest edge leaving it, then all of them are merged
+	while(merged) {
+
+		merged = 0;
+
+		for(i = 0; i < MAX_VERTICES; i++) {
+			best_w[i] = -1;
+		}
+
+		for(u = 0; u <= graph->max_vertex; u++) {
+
+			for(v = u + 1; v <= graph->max_vertex; v++) {
+
+				//Undirected view: u->v and v->u are one edge with the smaller weight
+				int w = graph->adj_matrix[u][v];
+				int back = graph->adj_matrix[v][u];
+
+				if(back > 0 && (w <= 0 || back < w)) {
+					w = back;
+				}
+				if(w <= 0) {
+					continue;
+				}
+
+				int ru = union_find_root(parent, u);
+				int rv = union_find_root(parent, v);
+
+				if(ru == rv) {
+					continue;
+				}
+
+				if(best_w[ru] == -1 || msf_edge_less(u, v, w, best_u[ru], best_v[ru], best_w[ru])) {
+					best_u[ru] = u;
+					best_v[ru] = v;
+					best_w[ru] = w;
+				}
+				if(best_w[rv] == -1 || msf_edge_less(u, v, w, best_u[rv], best_v[rv], best_w[rv])) {
+					best_u[rv] = u;
+					best_v[rv] = v;
+					best_w[rv] = w;
+				}
+			}
+		}
+
+		//Two components may pick the same edge; the second link finds them already merged
+		for(i = 0; i < MAX_VERTICES; i++) {
+
+			if(best_w[i] != -1 && union_find_link(parent, best_u[i], best_v[i])) {
+				chosen[count++] = best_u[i];
+				chosen[count++] = best_v[i];
+				sum += best_w[i];
+				merged = 1;
+			}
+		}
+	}
+
+	//Malloc a dynamic array with the chosen (v1, v2) pairs +1 (for the extra -1 at the end)
+	int *arr = malloc(sizeof(int) * (count+1));
+	if(arr == NULL) {
+		return NULL;
+	}
+
+	memcpy(arr, chosen, sizeof(int) * count);
+	arr[count] = -1;
+
+	if(total_weight != NULL) {
+		*total_weight = sum;
+	}
+
+	return arr;
+}
+
+// Concurrent Mutation Operations
+/* Notes:
+* 1. Every cell of adj_matrix is updated with a single atomic operation, so any number of threads
+*    may add vertices and add or remove edges at the same time without locks
+* 2. Results match the plain functions (an edge write still overwrites the old weight)
+* 3. graph_remove_vertex, graph_load_file and graph_reorder must not run alongside these
+* 4. Only writers are safe against each other. The plain query functions read the matrix without
+*    atomics, so querying a graph while these run is a data race; use a versioned graph instead
+*/
+int graph_add_vertex_concurrent(Graph *graph, int v1) {
+	STATS_SCOPE(GRAPH_OP_ADD_VERTEX_CONCURRENT);
+
+	//Handler for malloc errors or invalid v1
+	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES) {
+    	return -1;
+  	}
+
+	//Claim the vertex; if another thread (or an earlier call) already did, that is a success too
+	int expected = -1;
+	__atomic_compare_exchange_n(&graph->adj_matrix[v1][v1], &expected, 0, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	//Raise max_vertex to v1 unless another thread already raised it past v1
+	int max = __atomic_load_n(&graph->max_vertex, __ATOMIC_SEQ_CST);
+
+	while(max < v1 && !__atomic_compare_exchange_n(&graph->max_vertex, &max, v1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+		//max now holds the latest value, try again
+	}
+
+	return 0;
+}
+
+int graph_add_edge_concurrent(Graph *graph, int v1, int v2, int wt) {
+	STATS_SCOPE(GRAPH_OP_ADD_EDGE_CONCURRENT);
+
+	//Handler for malloc errors or invalid v1 or v2
+	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES || v2 < 0 || v2 >= MAX_VERTICES) {
+    	return -1;
+  	}
+
+  	//Handler for when v1 or v2 does not exist
+  	if(__atomic_load_n(&graph->adj_matrix[v1][v1], __ATOMIC_SEQ_CST) == -1 || __atomic_load_n(&graph->adj_matrix[v2][v2], __ATOMIC_SEQ_CST) == -1) {
+  		return -1;
+  	}
+
+  	//Handler for when wt <= 0 (Since wt is always > 0)
+  	if(wt <= 0) {
+  		return -1;
+  	}
+
+  	//Set the corresponding edge with the weight and return success
+  	__atomic_store_n(&graph->adj_matrix[v1][v2], wt, __ATOMIC_SEQ_CST);
+  	edge_bits_sync_atomic(graph, v1, v2);
+  	return 0;
+}
+
+int graph_remove_edge_concurrent(Graph *graph, int v1, int v2) {
+	STATS_SCOPE(GRAPH_OP_REMOVE_EDGE_CONCURRENT);
+
+	//Handler for malloc errors or invalid v1 or v2
+	if(graph == NULL || v1 < 0 || v1 >= MAX_VERTICES || v2 < 0 || v2 >= MAX_VERTICES) {
+    	return -1;
+  	}
+
+  	//Handler for when v1 or v2 does not exist
+  	if(__atomic_load_n(&graph->adj_matrix[v1][v1], __ATOMIC_SEQ_CST) == -1 || __atomic_load_n(&graph->adj_matrix[v2][v2], __ATOMIC_SEQ_CST) == -1) {
+  		return -1;
+  	}
+
+	//Reset the edge only if it still exists, so exactly one of several racing removals succeeds
+	int old = __atomic_load_n(&graph->adj_matrix[v1][v2], __ATOMIC_SEQ_CST);
+
+	while(old > 0) {
+
+		if(__atomic_compare_exchange_n(&graph->adj_matrix[v1][v2], &old, -1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+			edge_bits_sync_atomic(graph, v1, v2);
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+
+// Versioned Graph Operations
+/* Notes:
+* 1. One writer and up to MAX_READERS readers (each with its own reader slot) may run concurrently
+* 2. Published versions are never modified; the writer edits a private draft and swaps it in
+* 3. A reader announces the epoch it entered in before loading the current version. A retired
+*    version is freed only once every active reader entered after it was retired.
+* 4. A slot holds one version at a time: acquiring a slot that is already held fails, since
+*    overwriting its epoch could let the version it still holds be freed
+*/
+
+//Helper function for versioned graphs: frees every retired version no active reader can still hold
+void versioned_reclaim(VersionedGraph *vgraph) {
+
+	unsigned long oldest = __atomic_load_n(&vgraph->epoch, __ATOMIC_SEQ_CST);
+	int i, j = 0;
+
+	//Find the oldest epoch any active reader entered in (0 means the slot is idle)
+	for(i = 0; i < MAX_READERS; i++) {
+
+		unsigned long e = __atomic_load_n(&vgraph->reader_epoch[i], __ATOMIC_SEQ_CST);
+
+		if(e != 0 && e < oldest) {
+			oldest = e;
+		}
+	}
+
+	//Versions retired before that epoch are unreachable, keep the rest
+	for(i = 0; i < vgraph->num_retired; i++) {
+
+		if(vgraph->retired_epoch[i] < oldest) {
+			free(vgraph->retired[i]);
+		}
+		else {
+			vgraph->retired[j] = vgraph->retired[i];
+			vgraph->retired_epoch[j] = vgraph->retired_epoch[i];
+			j++;
+		}
+	}
+
+	vgraph->num_retired = j;
+}
+
+VersionedGraph *graph_versioned_initialize(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_INITIALIZE);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return NULL;
+	}
+
+	//Version 1 is a copy of the given graph
+	VersionedGraph *vgraph_ptr = malloc(sizeof(VersionedGraph));
+	Graph *first = graph_clone(graph);
+
+	if(vgraph_ptr == NULL || first == NULL) {
+		free(vgraph_ptr);
+		free(first);
+		return NULL;
+	}
+
+	vgraph_ptr->current = first;
+	vgraph_ptr->draft = NULL;
+	vgraph_ptr->num_retired = 0;
+	vgraph_ptr->epoch = 1;
+	memset(vgraph_ptr->reader_epoch, 0, sizeof(vgraph_ptr->reader_epoch));
+
+	return vgraph_ptr;
+}
+
+Graph *graph_versioned_acquire(VersionedGraph *vgraph, int reader) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_ACQUIRE);
+
+	//Handler for malloc errors or invalid reader slot
+	if(vgraph == NULL || reader < 0 || reader >= MAX_READERS) {
+		return NULL;
+	}
+
+	//A slot already in use must be released first
+	if(__atomic_load_n(&vgraph->reader_epoch[reader], __ATOMIC_SEQ_CST) != 0) {
+		return NULL;
+	}
+
+	//Announce the epoch first, then load the version; both are single atomic operations (wait-free)
+	unsigned long e = __atomic_load_n(&vgraph->epoch, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&vgraph->reader_epoch[reader], e, __ATOMIC_SEQ_CST);
+
+	return __atomic_load_n(&vgraph->current, __ATOMIC_SEQ_CST);
+}
+
+void graph_versioned_release(VersionedGraph *vgraph, int reader) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_RELEASE);
+
+	//Handler for malloc errors or invalid reader slot
+	if(vgraph == NULL || reader < 0 || reader >= MAX_READERS) {
+		return;
+	}
+
+	__atomic_store_n(&vgraph->reader_epoch[reader], 0, __ATOMIC_SEQ_CST);
+}
+
+Graph *graph_versioned_begin(VersionedGraph *vgraph) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_BEGIN);
+
+	//Handler for malloc errors
+	if(vgraph == NULL) {
+		return NULL;
+	}
+
+	//An open batch keeps collecting mutations into the same draft
+	if(vgraph->draft != NULL) {
+		return vgraph->draft;
+	}
+
+	vgraph->draft = graph_clone(vgraph->current);
+	return vgraph->draft;
+}
+
+long graph_versioned_publish(VersionedGraph *vgraph) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_PUBLISH);
+
+	//Handler for malloc errors or no open batch
+	if(vgraph == NULL || vgraph->draft == NULL) {
+		return -1;
+	}
+
+	//Make room for the version being retired, waiting on slow readers if needed
+	versioned_reclaim(vgraph);
+	while(vgraph->num_retired == MAX_RETIRED) {
+		versioned_reclaim(vgraph);
+	}
+
+	//Swap in the draft, then tag the old version with the epoch before advancing it
+	Graph *old = __atomic_exchange_n(&vgraph->current, vgraph->draft, __ATOMIC_SEQ_CST);
+	unsigned long e = __atomic_fetch_add(&vgraph->epoch, 1, __ATOMIC_SEQ_CST);
+
+	vgraph->retired[vgraph->num_retired] = old;
+	vgraph->retired_epoch[vgraph->num_retired] = e;
+	vgraph->num_retired++;
+	vgraph->draft = NULL;
+
+	//Return the new version number on success
+	return (long)(e + 1);
+}
+
+void graph_versioned_free(VersionedGraph *vgraph) {
+	STATS_SCOPE(GRAPH_OP_VERSIONED_FREE);
+
+	//Handler for malloc errors
+	if(vgraph == NULL) {
+		return;
+	}
+
+	//No readers may be active here, so every version can go
+	int i;
+	for(i = 0; i < vgraph->num_retired; i++) {
+		free(vgraph->retired[i]);
+	}
+
+	free(vgraph->draft);
+	free(vgraph->current);
+	free(vgraph);
+}
+
+
+// Input/Output Operations
+void graph_print(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_PRINT);
+	
+	//Handler for malloc errors
+	if(graph == NULL) {
+    	return;
+  	}
+  	//Handler for the case when the graph is just initialized
+  	if(graph->max_vertex == -1) {
+  		printf("\nNo elements in the Graph currently.");
+  		return;
   	}
 
   	char dot[] = ".";
@@ -530,6 +1988,7 @@ void graph_print(Graph *graph) {
 }
 
 void graph_output_dot(Graph *graph, char *filename) {
+	STATS_SCOPE(GRAPH_OP_OUTPUT_DOT);
 	
 	//Handler for malloc or filename errors
 	if(graph == NULL || filename == NULL) {
@@ -570,6 +2029,7 @@ void graph_output_dot(Graph *graph, char *filename) {
 }
 
 int graph_load_file(Graph *graph, char *filename) {
+	STATS_SCOPE(GRAPH_OP_LOAD_FILE);
 
 	//Handler for malloc or filename errors
 	if(graph == NULL || filename == NULL) {
@@ -580,16 +2040,15 @@ int graph_load_file(Graph *graph, char *filename) {
 
   	//Reinitializing a new graph in case an old graph exists
   	graph -> max_vertex = -1;  	
-    //Default visited[]
-    for(i = 0; i < MAX_VERTICES; i++) { 
-    	graph->visited[i] = 0;
-    }    	
     //Default adj_matrix[]
     for(i = 0; i < MAX_VERTICES; i++) { 
     	for(j = 0; j < MAX_VERTICES; j++) {
     		graph->adj_matrix[i][j] = -1;
     	}
     }	
+    //Default edge bits
+    memset(graph->out_edges, 0, sizeof(graph->out_edges));
+    memset(graph->in_edges, 0, sizeof(graph->in_edges));
 	//Open filename for reading
 	FILE *fp = fopen(filename, "r");
 	if(fp == NULL) {
@@ -632,6 +2091,7 @@ int graph_load_file(Graph *graph, char *filename) {
 }
 
 int graph_save_file(Graph *graph, char *filename) {
+	STATS_SCOPE(GRAPH_OP_SAVE_FILE);
 
 	//Handler for malloc or filename errors
 	if(graph == NULL || filename == NULL) {
@@ -666,4 +2126,325 @@ int graph_save_file(Graph *graph, char *filename) {
     //Close file and return success
 	fclose(fp);
 	return 0;
+}
+
+
+// Streaming Input Operations
+/* Notes:
+* 1. Lines use the graph_load_file format ("x" or "x,y,w") and may be split anywhere across feeds
+* 2. At most one partial line and GRAPH_STREAM_BATCH parsed lines are buffered at any time
+* 3. Batches are applied with the concurrent mutation functions, so a stream can run on its own thread
+*    next to other writers, but not next to readers of the same graph
+* 4. To query while streaming, feed a graph_versioned_begin() draft, then graph_stream_flush() and
+*    graph_versioned_publish(). Point stream->graph at the next draft before feeding again; the
+*    carried partial line is kept.
+*/
+
+//Helper function for streams: adds the vertices and edges of every buffered line to the graph
+void stream_apply_batch(GraphStream *stream) {
+
+	int i;
+
+	for(i = 0; i < stream->batch_len; i++) {
+
+		int *entry = stream->batch[i];
+
+		graph_add_vertex_concurrent(stream->graph, entry[0]);
+
+		if(entry[1] != -1) {
+			graph_add_vertex_concurrent(stream->graph, entry[1]);
+		}
+
+		if(entry[2] != -1) {
+			graph_add_edge_concurrent(stream->graph, entry[0], entry[1], entry[2]);
+		}
+	}
+
+	stream->batch_len = 0;
+}
+
+//Helper function for streams: parses one complete line into the batch, applying the batch when full
+void stream_parse_line(GraphStream *stream, char *line) {
+
+	int *entry = stream->batch[stream->batch_len];
+
+	entry[0] = entry[1] = entry[2] = -1;
+
+	//Get x, y and w if they exist (sscanf rather than strtok, so streams on other threads don't interfere)
+	if(sscanf(line, "%d,%d,%d", &entry[0], &entry[1], &entry[2]) < 1) {
+		return;
+	}
+
+	stream->lines++;
+	stream->batch_len++;
+
+	if(stream->batch_len == GRAPH_STREAM_BATCH) {
+		stream_apply_batch(stream);
+	}
+}
+
+GraphStream *graph_stream_open(Graph *graph) {
+	STATS_SCOPE(GRAPH_OP_STREAM_OPEN);
+
+	//Handler for malloc errors
+	if(graph == NULL) {
+		return NULL;
+	}
+
+	//Unlike graph_load_file, the graph is not reset; streamed edges add to what is there
+	GraphStream *stream_ptr = malloc(sizeof(GraphStream));
+	if(stream_ptr == NULL) {
+		return NULL;
+	}
+
+	stream_ptr->graph = graph;
+	stream_ptr->line_len = 0;
+	stream_ptr->overflow = 0;
+	stream_ptr->batch_len = 0;
+	stream_ptr->lines = 0;
+
+	return stream_ptr;
+}
+
+int graph_stream_feed(GraphStream *stream, const char *buf, size_t len) {
+	STATS_SCOPE(GRAPH_OP_STREAM_FEED);
+
+	//Handler for malloc or buffer errors
+	if(stream == NULL || (buf == NULL && len > 0)) {
+		return -1;
+	}
+
+	size_t i;
+
+	for(i = 0; i < len; i++) {
+
+		//A newline completes the carried line
+		if(buf[i] == '\n') {
+
+			if(!stream->overflow) {
+				stream->line[stream->line_len] = '\0';
+				stream_parse_line(stream, stream->line);
+			}
+
+			stream->line_len = 0;
+			stream->overflow = 0;
+		}
+		//Lines longer than a file entry can be are dropped whole
+		else if(stream->line_len == FILE_ENTRY_MAX_LEN - 1) {
+			stream->overflow = 1;
+		}
+		else if(!stream->overflow) {
+			stream->line[stream->line_len++] = buf[i];
+		}
+	}
+	//Return success
+	return 0;
+}
+
+long graph_stream_flush(GraphStream *stream) {
+	STATS_SCOPE(GRAPH_OP_STREAM_FLUSH);
+
+	//Handler for malloc errors
+	if(stream == NULL) {
+		return -1;
+	}
+
+	//Apply the complete lines still buffered; a partial line waits for the rest of it
+	stream_apply_batch(stream);
+
+	//Return number of lines parsed so far on success
+	return stream->lines;
+}
+
+long graph_stream_close(GraphStream *stream) {
+	STATS_SCOPE(GRAPH_OP_STREAM_CLOSE);
+
+	//Handler for malloc errors
+	if(stream == NULL) {
+		return -1;
+	}
+
+	//A last line without a newline still counts
+	if(stream->line_len > 0 && !stream->overflow) {
+		stream->line[stream->line_len] = '\0';
+		stream_parse_line(stream, stream->line);
+	}
+
+	stream_apply_batch(stream);
+
+	long lines = stream->lines;
+	free(stream);
+
+	//Return number of lines parsed on success
+	return lines;
+}
+
+// Statistics Operations
+//Names of the counted operations, in enum graph_op order
+const char *stats_op_names[GRAPH_OP_COUNT] = {
+	"initialize",
+	"clone",
+	"add_vertex",
+	"contains_vertex",
+	"remove_vertex",
+	"add_edge",
+	"contains_edge",
+	"remove_edge",
+	"num_vertices",
+	"num_edges",
+	"total_weight",
+	"get_degree",
+	"get_edge_weight",
+	"is_neighbor",
+	"get_predecessors",
+	"get_successors",
+	"top_k_edges",
+	"edges_in_weight_range",
+	"weighted_degree",
+	"has_path",
+	"connected_components",
+	"pagerank",
+	"personalized_pagerank",
+	"triangle_count",
+	"clustering_coefficient",
+	"betweenness",
+	"bandwidth",
+	"reorder",
+	"khop",
+	"induced_subgraph",
+	"minimum_spanning_forest",
+	"add_vertex_concurrent",
+	"add_edge_concurrent",
+	"remove_edge_concurrent",
+	"versioned_initialize",
+	"versioned_acquire",
+	"versioned_release",
+	"versioned_begin",
+	"versioned_publish",
+	"versioned_free",
+	"print",
+	"output_dot",
+	"load_file",
+	"save_file",
+	"stream_open",
+	"stream_feed",
+	"stream_flush",
+	"stream_close"
+};
+
+int graph_stats_snapshot(GraphStats *stats) {
+
+	//Handler for a missing output struct
+	if(stats == NULL) {
+		return -1;
+	}
+
+	memset(stats, 0, sizeof(GraphStats));
+
+#ifdef GRAPH_STATS
+	//Sum every thread's slot; GraphStats is all unsigned long counters, so add it field by field
+	StatsSlot *slot = __atomic_load_n(&stats_slots, __ATOMIC_ACQUIRE);
+	unsigned long *total = (unsigned long *)stats;
+	int i, n = sizeof(GraphStats) / sizeof(unsigned long);
+
+	for(; slot != NULL; slot = slot->next) {
+
+		unsigned long *counter = (unsigned long *)&slot->stats;
+
+		for(i = 0; i < n; i++) {
+			total[i] += __atomic_load_n(&counter[i], __ATOMIC_RELAXED);
+		}
+	}
+	//Return success
+	return 0;
+#else
+	//Statistics were compiled out
+	return -1;
+#endif
+}
+
+void graph_stats_reset() {
+
+#ifdef GRAPH_STATS
+	//Calls finishing on other threads during the reset may keep their old totals
+	StatsSlot *slot = __atomic_load_n(&stats_slots, __ATOMIC_ACQUIRE);
+	int i, n = sizeof(GraphStats) / sizeof(unsigned long);
+
+	for(; slot != NULL; slot = slot->next) {
+
+		unsigned long *counter = (unsigned long *)&slot->stats;
+
+		for(i = 0; i < n; i++) {
+			__atomic_store_n(&counter[i], 0, __ATOMIC_RELAXED);
+		}
+	}
+#endif
+}
+
+int graph_stats_dump(char *filename, int json) {
+
+	GraphStats stats;
+	int i, b;
+
+	if(graph_stats_snapshot(&stats) == -1) {
+		return -1;
+	}
+
+	//Open filename for writing (overwrites everytime it's opened), or use stdout when no filename is given
+	FILE *fp = (filename == NULL) ? stdout : fopen(filename, "w");
+	if(fp == NULL) {
+		return -1;
+	}
+
+	if(json) {
+
+		fprintf(fp, "{\"operations\": {");
+
+		for(i = 0; i < GRAPH_OP_COUNT; i++) {
+
+			fprintf(fp, "%s\"%s\": {\"calls\": %lu, \"total_ns\": %lu, \"latency_log2_ns\": [",
+				(i == 0) ? "" : ", ", stats_op_names[i], stats.calls[i], stats.total_ns[i]);
+
+			for(b = 0; b < GRAPH_STATS_BUCKETS; b++) {
+				fprintf(fp, "%s%lu", (b == 0) ? "" : ", ", stats.latency[i][b]);
+			}
+
+			fprintf(fp, "]}");
+		}
+
+		fprintf(fp, "}, \"has_path\": {\"searches\": %lu, \"vertices_visited\": %lu, \"edges_visited\": %lu}}\n",
+			stats.path_searches, stats.path_vertices_visited, stats.path_edges_visited);
+	}
+	else {
+
+		//Only operations that were called, with their non-empty latency buckets
+		for(i = 0; i < GRAPH_OP_COUNT; i++) {
+
+			if(stats.calls[i] == 0) {
+				continue;
+			}
+
+			fprintf(fp, "%-24s calls=%lu total_ns=%lu avg_ns=%lu\n", stats_op_names[i], stats.calls[i],
+				stats.total_ns[i], stats.total_ns[i] / stats.calls[i]);
+
+			for(b = 0; b < GRAPH_STATS_BUCKETS; b++) {
+
+				if(stats.latency[i][b] != 0) {
+					fprintf(fp, "    <%lu ns: %lu\n", 2UL << b, stats.latency[i][b]);
+				}
+			}
+		}
+
+		fprintf(fp, "has_path searches=%lu vertices_visited=%lu edges_visited=%lu\n",
+			stats.path_searches, stats.path_vertices_visited, stats.path_edges_visited);
+	}
+
+	//Close file (but never stdout) and return success
+	if(fp != stdout) {
+		fclose(fp);
+	}
+	else {
+		fflush(fp);
+	}
+	return 0;
 }
\ No newline at end of file
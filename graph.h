@@ -1,20 +1,125 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <stddef.h>
+
 #define FILE_ENTRY_MAX_LEN  30
 #define MAX_VERTICES        20
+#define MAX_READERS         16
+#define MAX_RETIRED         8
+#define GRAPH_STREAM_BATCH  64
+
+// Vertex reordering strategies for graph_reorder(). Reordering renumbers the vertices callers see:
+// old vertex old_ids[i] becomes vertex i, and old vertex v becomes new_ids[v] (-1 for no vertex).
+// It returns the new bandwidth and stores the old one in *bandwidth_before; new_ids and bandwidth_before may be NULL.
+#define GRAPH_ORDER_RCM     0
+#define GRAPH_ORDER_DEGREE  1
+#define GRAPH_ORDER_BFS     2
+
+// Edge directions for graph_khop()
+#define GRAPH_DIR_OUT       0
+#define GRAPH_DIR_IN        1
+#define GRAPH_DIR_BOTH      2
+
+#define GRAPH_BITSET_WORDS  ((MAX_VERTICES + 31) / 32)
 
 typedef struct graph_struct {
   int max_vertex;
   int adj_matrix[MAX_VERTICES][MAX_VERTICES];  
-  int visited[MAX_VERTICES];
+  unsigned int out_edges[MAX_VERTICES][GRAPH_BITSET_WORDS];  // bit j of row i set when adj_matrix[i][j] > 0
+  unsigned int in_edges[MAX_VERTICES][GRAPH_BITSET_WORDS];   // bit i of row j set when adj_matrix[i][j] > 0
 } Graph;
 
+typedef struct versioned_graph_struct {
+  Graph *current;                      // published version, never modified
+  Graph *draft;                        // writer's private copy, NULL when no batch is open
+  Graph *retired[MAX_RETIRED];         // replaced versions waiting for readers to leave
+  unsigned long retired_epoch[MAX_RETIRED];
+  int num_retired;
+  unsigned long epoch;                 // version number of current
+  unsigned long reader_epoch[MAX_READERS];  // epoch each reader entered in, 0 when idle
+} VersionedGraph;
+
+typedef struct graph_stream_struct {
+  Graph *graph;                        // where batches are applied, may move to a new draft after a flush
+  char line[FILE_ENTRY_MAX_LEN];       // partial line carried between feeds
+  int line_len;
+  int overflow;                        // current line is too long and is being skipped
+  int batch[GRAPH_STREAM_BATCH][3];    // parsed x, y, w (-1 when missing), not yet applied
+  int batch_len;
+  long lines;
+} GraphStream;
+
+// Public operations counted by the statistics API (one per function above the Statistics section)
+enum graph_op {
+  GRAPH_OP_INITIALIZE,
+  GRAPH_OP_CLONE,
+  GRAPH_OP_ADD_VERTEX,
+  GRAPH_OP_CONTAINS_VERTEX,
+  GRAPH_OP_REMOVE_VERTEX,
+  GRAPH_OP_ADD_EDGE,
+  GRAPH_OP_CONTAINS_EDGE,
+  GRAPH_OP_REMOVE_EDGE,
+  GRAPH_OP_NUM_VERTICES,
+  GRAPH_OP_NUM_EDGES,
+  GRAPH_OP_TOTAL_WEIGHT,
+  GRAPH_OP_GET_DEGREE,
+  GRAPH_OP_GET_EDGE_WEIGHT,
+  GRAPH_OP_IS_NEIGHBOR,
+  GRAPH_OP_GET_PREDECESSORS,
+  GRAPH_OP_GET_SUCCESSORS,
+  GRAPH_OP_TOP_K_EDGES,
+  GRAPH_OP_EDGES_IN_WEIGHT_RANGE,
+  GRAPH_OP_WEIGHTED_DEGREE,
+  GRAPH_OP_HAS_PATH,
+  GRAPH_OP_CONNECTED_COMPONENTS,
+  GRAPH_OP_PAGERANK,
+  GRAPH_OP_PERSONALIZED_PAGERANK,
+  GRAPH_OP_TRIANGLE_COUNT,
+  GRAPH_OP_CLUSTERING_COEFFICIENT,
+  GRAPH_OP_BETWEENNESS,
+  GRAPH_OP_BANDWIDTH,
+  GRAPH_OP_REORDER,
+  GRAPH_OP_KHOP,
+  GRAPH_OP_INDUCED_SUBGRAPH,
+  GRAPH_OP_MINIMUM_SPANNING_FOREST,
+  GRAPH_OP_ADD_VERTEX_CONCURRENT,
+  GRAPH_OP_ADD_EDGE_CONCURRENT,
+  GRAPH_OP_REMOVE_EDGE_CONCURRENT,
+  GRAPH_OP_VERSIONED_INITIALIZE,
+  GRAPH_OP_VERSIONED_ACQUIRE,
+  GRAPH_OP_VERSIONED_RELEASE,
+  GRAPH_OP_VERSIONED_BEGIN,
+  GRAPH_OP_VERSIONED_PUBLISH,
+  GRAPH_OP_VERSIONED_FREE,
+  GRAPH_OP_PRINT,
+  GRAPH_OP_OUTPUT_DOT,
+  GRAPH_OP_LOAD_FILE,
+  GRAPH_OP_SAVE_FILE,
+  GRAPH_OP_STREAM_OPEN,
+  GRAPH_OP_STREAM_FEED,
+  GRAPH_OP_STREAM_FLUSH,
+  GRAPH_OP_STREAM_CLOSE,
+  GRAPH_OP_COUNT
+};
+
+#define GRAPH_STATS_BUCKETS 32
+
+typedef struct graph_stats_struct {
+  unsigned long calls[GRAPH_OP_COUNT];
+  unsigned long total_ns[GRAPH_OP_COUNT];
+  unsigned long latency[GRAPH_OP_COUNT][GRAPH_STATS_BUCKETS];  // bucket b counts calls taking [2^b, 2^(b+1)) ns
+  unsigned long path_searches;                                 // graph_has_path calls that ran a DFS
+  unsigned long path_vertices_visited;
+  unsigned long path_edges_visited;
+} GraphStats;
+
 // Prototypes
 // ---------------------------------------------------
 
 // Initialization Functions
 Graph *graph_initialize();
+Graph *graph_clone(Graph *graph);
 
 // Vertex Operations
 int graph_add_vertex(Graph *graph, int v1);
@@ -37,14 +142,59 @@ int graph_get_edge_weight(Graph *graph, int v1, int v2);
 int graph_is_neighbor(Graph *graph, int v1, int v2);
 int *graph_get_predecessors(Graph *graph, int v1);
 int *graph_get_successors(Graph *graph, int v1);
+int *graph_top_k_edges(Graph *graph, int v1, int k);
+int *graph_edges_in_weight_range(Graph *graph, int min_wt, int max_wt);
+int graph_weighted_degree(Graph *graph, int v1);
 
 // Graph Path Operations
 int graph_has_path(Graph *graph, int v1, int v2);
 
+// Graph Analytics Operations
+int graph_connected_components(Graph *graph, int *components);
+int graph_pagerank(Graph *graph, double damping, int max_iter, double tolerance, double *ranks);
+int graph_personalized_pagerank(Graph *graph, int v1, double damping, int max_iter, double tolerance, double *ranks);
+int graph_triangle_count(Graph *graph, int *counts);
+double graph_clustering_coefficient(Graph *graph, int v1);
+int graph_betweenness(Graph *graph, int samples, double *centrality);
+int graph_bandwidth(Graph *graph);
+int graph_reorder(Graph *graph, int strategy, int *old_ids, int *new_ids, int *bandwidth_before);
+Graph *graph_khop(Graph *graph, int v1, int k, int direction);
+Graph *graph_induced_subgraph(Graph *graph, int *vertices);
+int *graph_minimum_spanning_forest(Graph *graph, int *total_weight);
+
+// Concurrent Mutation Operations (safe against each other only; do not query the graph meanwhile)
+int graph_add_vertex_concurrent(Graph *graph, int v1);
+int graph_add_edge_concurrent(Graph *graph, int v1, int v2, int wt);
+int graph_remove_edge_concurrent(Graph *graph, int v1, int v2);
+
+// Versioned Graph Operations (one version per reader slot: acquire returns NULL until the slot is released)
+VersionedGraph *graph_versioned_initialize(Graph *graph);
+Graph *graph_versioned_acquire(VersionedGraph *vgraph, int reader);
+void graph_versioned_release(VersionedGraph *vgraph, int reader);
+Graph *graph_versioned_begin(VersionedGraph *vgraph);
+long graph_versioned_publish(VersionedGraph *vgraph);
+void graph_versioned_free(VersionedGraph *vgraph);
+
 // Input/Output Operations
 void graph_print(Graph *graph);
 void graph_output_dot(Graph *graph, char *filename);
 int graph_load_file(Graph *graph, char *filename);
 int graph_save_file(Graph *graph, char *filename);
 
+// Streaming Input Operations
+// Parsed lines are applied in batches of GRAPH_STREAM_BATCH, at a flush or at close. Streaming into a
+// graph that is being queried is unsupported; to read while streaming, feed a versioned draft:
+//   stream = graph_stream_open(graph_versioned_begin(vgraph));
+//   graph_stream_feed(stream, buf, len); graph_stream_flush(stream); graph_versioned_publish(vgraph);
+//   stream->graph = graph_versioned_begin(vgraph);   // then keep feeding
+GraphStream *graph_stream_open(Graph *graph);
+int graph_stream_feed(GraphStream *stream, const char *buf, size_t len);
+long graph_stream_flush(GraphStream *stream);
+long graph_stream_close(GraphStream *stream);
+
+// Statistics Operations (counters are only collected when built with -DGRAPH_STATS)
+int graph_stats_snapshot(GraphStats *stats);
+void graph_stats_reset();
+int graph_stats_dump(char *filename, int json);
+
 #endif
\ No newline at end of file
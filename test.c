@@ -4,6 +4,199 @@
 
 #include "graph.h"
 
+#define BATCH_BUFFER_SIZE  (1 << 20)
+
+/* Batch mode: ./test -b [file]
+* Reads one operation per line ("opt x y w", same opcodes as the menu; 16 takes a filename instead
+* of x) from the file or stdin until EOF or -1, and writes one compact result line per operation.
+*/
+
+//Helper function for batch mode: prints a -1 terminated vertex list (and frees it), or "null"
+void batch_print_list(FILE *out, int *arr) {
+
+	if(arr == NULL) {
+		fputs("null\n", out);
+		return;
+	}
+
+	int i;
+	for(i = 0; arr[i] != -1; i++) {
+		fprintf(out, "%d ", arr[i]);
+	}
+
+	fputs("-1\n", out);
+	free(arr);
+}
+
+//Helper function for batch mode: prints a result, then (only if it succeeded) the vertex:value pairs
+//of every vertex that has a value (-1 marks vertices without one)
+void batch_print_labels(FILE *out, int result, int *values) {
+
+	fprintf(out, "%d", result);
+
+	if(result != -1) {
+
+		int i;
+		for(i = 0; i < MAX_VERTICES; i++) {
+			if(values[i] != -1) {
+				fprintf(out, " %d:%d", i, values[i]);
+			}
+		}
+	}
+
+	fputs("\n", out);
+}
+
+//Helper function for batch mode: prints a result, then (only if it succeeded) the vertex:score pairs
+//of every existing vertex
+void batch_print_scores(FILE *out, Graph *graph, int result, double *scores) {
+
+	fprintf(out, "%d", result);
+
+	if(result != -1) {
+
+		int i;
+		for(i = 0; i < MAX_VERTICES; i++) {
+			if(graph_contains_vertex(graph, i)) {
+				fprintf(out, " %d:%.6f", i, scores[i]);
+			}
+		}
+	}
+
+	fputs("\n", out);
+}
+
+long run_batch(Graph *graph, FILE *in) {
+
+	//Large buffers on both ends so millions of operations don't turn into millions of syscalls
+	//(static, since stdout keeps using its buffer until the program exits)
+	static char in_buffer[BATCH_BUFFER_SIZE];
+	static char out_buffer[BATCH_BUFFER_SIZE];
+
+	setvbuf(in, in_buffer, _IOFBF, BATCH_BUFFER_SIZE);
+	setvbuf(stdout, out_buffer, _IOFBF, BATCH_BUFFER_SIZE);
+
+	char line[256];
+	char filename[100];
+	long count = 0;
+	int *arr = NULL;
+
+	while(fgets(line, sizeof(line), in) != NULL) {
+
+		int opt = 0, x = -1, y = -1, w = -1;
+
+		//Skip blank lines
+		if(sscanf(line, "%d %d %d %d", &opt, &x, &y, &w) < 1) {
+			continue;
+		}
+
+		if(opt == -1) {
+			break;
+		}
+
+		count++;
+
+		switch(opt) {
+
+			case 1:  printf("%d\n", graph_add_vertex(graph, x)); break;
+			case 2:  printf("%d\n", graph_add_edge(graph, x, y, w)); break;
+			case 3:  printf("%d\n", graph_remove_edge(graph, x, y)); break;
+			case 4:  printf("%d\n", graph_remove_vertex(graph, x)); break;
+			case 5:  printf("%d\n", graph_contains_vertex(graph, x)); break;
+			case 6:  printf("%d\n", graph_num_vertices(graph)); break;
+			case 7:  printf("%d\n", graph_num_edges(graph)); break;
+			case 8:  printf("%d\n", graph_get_degree(graph, x)); break;
+			case 9:  printf("%d\n", graph_total_weight(graph)); break;
+			case 10: batch_print_list(stdout, graph_get_successors(graph, x)); break;
+			case 11: batch_print_list(stdout, graph_get_predecessors(graph, x)); break;
+			case 12: printf("%d\n", graph_is_neighbor(graph, x, y)); break;
+			case 13: printf("%d\n", graph_get_edge_weight(graph, x, y)); break;
+			case 14: graph_output_dot(graph, "dotGraph.txt"); printf("0\n"); break;
+			case 15: printf("%d\n", graph_has_path(graph, x, y)); break;
+
+			case 16:
+				if(sscanf(line, "%*d %99s", filename) == 1) {
+					printf("%d\n", graph_load_file(graph, filename));
+				}
+				else {
+					printf("-1\n");
+				}
+			break;
+
+			case 17: graph_print(graph); printf("\n"); break;
+			case 18: printf("%d\n", graph_save_file(graph, "savedGraph.txt")); break;
+			case 19: printf("%d\n", graph_contains_edge(graph, x, y)); break;
+
+			//Per vertex results are printed as vertex:value pairs after the return value (each op
+			//has its own array, and nothing but -1 is printed when the call fails)
+			case 20: {
+				int labels[MAX_VERTICES];
+				batch_print_labels(stdout, graph_connected_components(graph, labels), labels);
+			}
+			break;
+
+			case 21: {
+				double ranks[MAX_VERTICES];
+				batch_print_scores(stdout, graph, graph_pagerank(graph, 0.85, 100, 1e-6, ranks), ranks);
+			}
+			break;
+
+			case 22: {
+				double ranks[MAX_VERTICES];
+				batch_print_scores(stdout, graph, graph_personalized_pagerank(graph, x, 0.85, 100, 1e-6, ranks), ranks);
+			}
+			break;
+
+			case 23: {
+				int triangles[MAX_VERTICES];
+				batch_print_labels(stdout, graph_triangle_count(graph, triangles), triangles);
+			}
+			break;
+
+			case 24: printf("%.6f\n", graph_clustering_coefficient(graph, x)); break;
+
+			case 25: {
+				double centrality[MAX_VERTICES];
+				batch_print_scores(stdout, graph, graph_betweenness(graph, x, centrality), centrality);
+			}
+			break;
+
+			case 26: {
+				int old_ids[MAX_VERTICES];
+				batch_print_labels(stdout, graph_reorder(graph, x, old_ids, NULL, NULL), old_ids);
+			}
+			break;
+
+			case 27: printf("%d\n", graph_stats_dump(NULL, 1)); break;
+
+			//The neighbourhood is reported as its vertex and edge counts
+			case 28: {
+				Graph *sub = graph_khop(graph, x, y, GRAPH_DIR_BOTH);
+				printf("%d %d\n", graph_num_vertices(sub), graph_num_edges(sub));
+				free(sub);
+			}
+			break;
+
+			case 29: batch_print_list(stdout, graph_top_k_edges(graph, x, y)); break;
+			case 30: batch_print_list(stdout, graph_edges_in_weight_range(graph, x, y)); break;
+			case 31: printf("%d\n", graph_weighted_degree(graph, x)); break;
+
+			//The total weight is printed first, then the chosen edges
+			case 32:
+				arr = graph_minimum_spanning_forest(graph, &x);
+				printf("%d ", (arr != NULL) ? x : -1);
+				batch_print_list(stdout, arr);
+			break;
+
+			default: printf("invalid\n"); break;
+		}
+	}
+
+	//Everything is written in one flush at the end (or whenever the buffer fills)
+	fflush(stdout);
+	return count;
+}
+
 int main(int argc, char *argv[]) {
 
 	Graph *graph = graph_initialize();
@@ -12,6 +205,27 @@ int main(int argc, char *argv[]) {
 		printf("Error in initializing graph. Exiting...\n");
 		return 0;
 	}
+
+	/* "-b [file]" runs operations from the file (or stdin) in batch mode, without the menu */
+	if(argc >= 2 && strcmp(argv[1], "-b") == 0) {
+
+		FILE *in = (argc >= 3) ? fopen(argv[2], "r") : stdin;
+
+		if(in == NULL) {
+			printf("Error in opening %s. Exiting...\n", argv[2]);
+			free(graph);
+			return 1;
+		}
+
+		run_batch(graph, in);
+
+		if(in != stdin) {
+			fclose(in);
+		}
+		free(graph);
+		return 0;
+	}
+
 	printf("Graph Initialized.\n");
 
 	/* Set up the filename with the default sample */
@@ -26,6 +240,9 @@ int main(int argc, char *argv[]) {
 	int flag = -1;
 	char buffer[10];
 	int *arr = NULL;
+	int components[MAX_VERTICES];
+	double ranks[MAX_VERTICES];
+	Graph *sub = NULL;
 
 	do {
 
@@ -51,6 +268,19 @@ int main(int argc, char *argv[]) {
 		printf("|17       | Print current Graph           |\n");
 		printf("|18       | Save current Graph            |\n");
 		printf("|19 X Y   | Contains Edge (Does Exist?)   |\n");
+		printf("|20       | Connected Components          |\n");
+		printf("|21       | PageRank of Graph             |\n");
+		printf("|22 X     | Personalized PageRank from X  |\n");
+		printf("|23       | Triangle Count of Graph       |\n");
+		printf("|24 X     | Clustering Coefficient of X   |\n");
+		printf("|25 X     | Betweenness (X Samples)       |\n");
+		printf("|26 X     | Reorder (0 RCM, 1 Deg, 2 BFS) |\n");
+		printf("|27       | Print Library Statistics      |\n");
+		printf("|28 X Y   | Y-hop Neighbourhood of X      |\n");
+		printf("|29 X Y   | Y Heaviest Edges out of X     |\n");
+		printf("|30 X Y   | Edges with Weight in [X, Y]   |\n");
+		printf("|31 X     | Weighted Degree of X          |\n");
+		printf("|32       | Minimum Spanning Forest       |\n");
 		printf("+---------+-------------------------------+\n");
 		printf("|-1       | Quit                          |\n");
 		printf(".-----------------------------------------.\n");
@@ -306,6 +536,224 @@ int main(int argc, char *argv[]) {
 				printf("\n\n");
 			break;
 
+			case 20:
+				flag = graph_connected_components(graph, components);
+				if(flag == -1) {
+					printf("\nError while finding Connected Components.");
+				}
+				else {
+					printf("\nNum of Connected Components = %d.\nComponent of each Vertex: ", flag);
+
+					int i;
+					for(i = 0; i < MAX_VERTICES; i++) {
+						if(components[i] != -1) {
+							printf("%d:%d ", i, components[i]);
+						}
+					}
+
+					graph_print(graph);
+				}
+				printf("\n\n");
+			break;
+
+			case 21:
+			case 22:
+				if(opt == 21) {
+					flag = graph_pagerank(graph, 0.85, 100, 1e-6, ranks);
+				}
+				else {
+					flag = graph_personalized_pagerank(graph, x, 0.85, 100, 1e-6, ranks);
+				}
+				if(flag == -1) {
+					printf("\nError while calculating PageRank.");
+				}
+				else {
+					printf("\nPageRank after %d iterations: ", flag);
+
+					int i;
+					for(i = 0; i < MAX_VERTICES; i++) {
+						if(graph_contains_vertex(graph, i)) {
+							printf("%d:%.4f ", i, ranks[i]);
+						}
+					}
+
+					graph_print(graph);
+				}
+				printf("\n\n");
+			break;
+
+			case 23: {
+				int triangles[MAX_VERTICES];
+
+				flag = graph_triangle_count(graph, triangles);
+				if(flag == -1) {
+					printf("\nError while counting Triangles.");
+				}
+				else {
+					printf("\nNum of Triangles = %d.\nTriangles at each Vertex: ", flag);
+
+					int i;
+					for(i = 0; i < MAX_VERTICES; i++) {
+						if(triangles[i] != -1) {
+							printf("%d:%d ", i, triangles[i]);
+						}
+					}
+
+					graph_print(graph);
+				}
+				printf("\n\n");
+			}
+			break;
+
+			case 24: {
+				double coefficient = graph_clustering_coefficient(graph, x);
+
+				if(coefficient < 0) {
+					printf("\nError while calculating Clustering Coefficient.");
+				}
+				else {
+					printf("\nClustering Coefficient = %.4f.", coefficient);
+					graph_print(graph);
+				}
+				printf("\n\n");
+			}
+			break;
+
+			case 25:
+				flag = graph_betweenness(graph, x, ranks);
+				if(flag == -1) {
+					printf("\nError while calculating Betweenness.");
+				}
+				else {
+					printf("\nBetweenness from %d sources: ", flag);
+
+					int i;
+					for(i = 0; i < MAX_VERTICES; i++) {
+						if(graph_contains_vertex(graph, i)) {
+							printf("%d:%.2f ", i, ranks[i]);
+						}
+					}
+
+					graph_print(graph);
+				}
+				printf("\n\n");
+			break;
+
+			case 26: {
+				int old_ids[MAX_VERTICES];
+				int bandwidth;
+
+				flag = graph_reorder(graph, x, old_ids, NULL, &bandwidth);
+				if(flag == -1) {
+					printf("\nError while reordering Graph.");
+				}
+				else {
+					printf("\nGraph reordered. Bandwidth %d -> %d.\nOriginal ID of each Vertex: ", bandwidth, flag);
+
+					int i;
+					for(i = 0; i < MAX_VERTICES && old_ids[i] != -1; i++) {
+						printf("%d:%d ", i, old_ids[i]);
+					}
+
+					graph_print(graph);
+				}
+				printf("\n\n");
+			}
+			break;
+
+			case 27:
+				if(graph_stats_dump(NULL, 0) == -1) {
+					printf("\nStatistics not available (build with -DGRAPH_STATS).");
+				}
+				printf("\n\n");
+			break;
+
+			case 28:
+				sub = graph_khop(graph, x, y, GRAPH_DIR_BOTH);
+				if(sub == NULL) {
+					printf("\nError while extracting Neighbourhood.");
+				}
+				else {
+					printf("\nNeighbourhood of %d within %d hops:", x, y);
+					graph_print(sub);
+					free(sub);
+				}
+				printf("\n\n");
+			break;
+
+			case 29:
+				arr = graph_top_k_edges(graph, x, y);
+				if(arr != NULL) {
+					printf("\nHeaviest successors are: ");
+
+					int i = 0;
+					while(arr[i] != -1) {
+						printf("%d(%d) ", arr[i], graph_get_edge_weight(graph, x, arr[i]));
+						i++;
+					}
+
+					graph_print(graph);
+					free(arr);
+				}
+				else {
+					printf("\nError while getting Heaviest Edges.");
+				}
+				printf("\n\n");
+			break;
+
+			case 30:
+				arr = graph_edges_in_weight_range(graph, x, y);
+				if(arr != NULL) {
+					printf("\nEdges in range are: ");
+
+					int i = 0;
+					while(arr[i] != -1) {
+						printf("%d->%d ", arr[i], arr[i+1]);
+						i += 2;
+					}
+
+					graph_print(graph);
+					free(arr);
+				}
+				else {
+					printf("\nError while getting Edges in range.");
+				}
+				printf("\n\n");
+			break;
+
+			case 31:
+				flag = graph_weighted_degree(graph, x);
+				if(flag == -1) {
+					printf("\nError while calculating weighted degree.");
+				}
+				else {
+					printf("\nWeighted degree = %d.", flag);
+					graph_print(graph);
+				}
+				printf("\n\n");
+			break;
+
+			case 32:
+				arr = graph_minimum_spanning_forest(graph, &flag);
+				if(arr != NULL) {
+					printf("\nSpanning forest edges are: ");
+
+					int i = 0;
+					while(arr[i] != -1) {
+						printf("%d-%d ", arr[i], arr[i+1]);
+						i += 2;
+					}
+
+					printf("\nTotal weight = %d.", flag);
+					graph_print(graph);
+					free(arr);
+				}
+				else {
+					printf("\nError while finding Minimum Spanning Forest.");
+				}
+				printf("\n\n");
+			break;
+
 			default:
 				printf("\nInvalid Input. Please try again.\n");
 			break;